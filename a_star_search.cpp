@@ -0,0 +1,282 @@
+///////////////////////////////////////////////
+// Assignment 1 : Lucas Silva                //
+// The implementation file for the A* search //
+///////////////////////////////////////////////
+
+#include <queue>          // std::priority_queue
+#include <vector>         // std::vector
+#include <cassert>
+
+#include "headers/a_star_search.h"
+#include "headers/bucket_queue.h"
+#include "headers/move_tables.h"
+
+#define RIGHT 1           // Represents a move to the right
+#define LEFT 2            // Represents a move to the left
+#define UP 3              // Represents a move up
+#define DOWN 4            // Represents a move down
+
+namespace {
+
+/**
+ * Makes the open list entry of a board.
+ * @param {Board} board The board.
+ * @param {uint32_t} node The index of the node of the board.
+ * @return {OpenEntry} the entry.
+ */
+template <int W, int H>
+OpenEntry<W, H> MakeEntry(const Board<W, H> &board, uint32_t node) {
+    OpenEntry<W, H> entry;
+    entry.state = board.GetState();
+    entry.node = node;
+    entry.rank = board.GetRank();
+    entry.moves_made = board.GetMovesMade();
+    return entry;
+}
+
+}  // namespace
+
+/**
+ * Searches for a shortest solution from the given board.
+ * @param {Board} board The initial board, must have been created.
+ * @return {boolean} true if a solution was found.
+ */
+template <int W, int H>
+bool AStarSearch<W, H>::Solve(Board<W, H> &board) {
+    assert(board.IsValid());
+
+    this->path_.clear();
+    this->closed_.Clear();
+    this->stats_ = SearchStats();
+    if (board.IsAtGoalState()) {
+        return true;
+    }
+
+    uint32_t answer;
+    if (this->use_buckets_) {
+        answer = this->Search_(board, this->buckets_);
+    } else {
+        answer = this->Search_(board, this->heap_);
+    }
+
+    // Follow the parents back to the initial board, node 0.
+    for (uint32_t step = answer; step != kNoNode && step != 0;
+         step = this->nodes_[step] >> 2) {
+        this->path_.push_back((this->nodes_[step] & 3) + 1);
+    }
+    this->path_.Reverse();
+
+    // The nodes are dropped at once, keeping their memory.
+    this->nodes_.clear();
+    return answer != kNoNode;
+}
+
+//////////////////////////////
+// Private helper functions //
+//////////////////////////////
+
+/**
+ * Runs the search with the given kind of open list.
+ * @param {Board} board The initial board.
+ * @param {Queue} pq The open list, emptied first.
+ * @return {uint32_t} the node at the goal state, or kNoNode if there is
+ *   none.
+ * @private
+ */
+template <int W, int H>
+template <class Queue>
+uint32_t AStarSearch<W, H>::Search_(const Board<W, H> &board, Queue &pq) {
+    // Every board is made by moving this one.
+    Board<W, H> scratch(board);
+    // The open list to hold all the board states, which keeps its memory
+    // from the last search.
+    pq.clear();
+    this->nodes_.clear();
+    // The initial board is node 0, its own parent, and its direction is
+    // never read.
+    pq.push(MakeEntry(board, this->AddNode_(0, RIGHT)));
+    // Every board already on the queue has been reached.
+    this->closed_.Insert(board.GetState(), board.GetMovesMade());
+
+    // While the board isn't empty, try to find the solution.
+    while (!pq.empty()) {
+        // Get the board with least rank from the top of the queue.
+        // Rank = moves made so far + estimated number of moves remaining
+        OpenEntry<W, H> current = pq.top();
+        pq.pop();
+
+        // Skip the board if a shorter path to it was pushed after it.
+        if (this->closed_.IsStale(current.state, current.moves_made)) {
+            continue;
+        }
+
+        // Move in all directions, adding the boards to the queue.
+        // If the goal state has been reached, then we are done!
+        uint32_t answer;
+        if (this->partial_expansion_) {
+            // Counted there, where a board put back is told apart.
+            answer = this->ExpandPartially_(current, scratch, pq);
+        } else {
+            this->stats_.CountExpansion(current.rank, current.moves_made);
+            answer = this->Expand_(current, scratch, pq);
+        }
+        if (answer != kNoNode) {
+            return answer;
+        }
+        this->stats_.UpdatePeakOpen(pq.size());
+    }
+
+    // No goal state was found!
+    return kNoNode;
+}
+
+/**
+ * Moves a board in every possible direction, and puts the new boards
+ * that haven't been reached in as few moves on the open list.
+ * @param {OpenEntry} entry The board to be expanded.
+ * @param {Board} scratch A board that is moved to make the new boards.
+ * @param {Queue} queue The open list.
+ * @return {uint32_t} a new node at the goal state, or kNoNode.
+ * @private
+ */
+template <int W, int H>
+template <class Queue>
+uint32_t AStarSearch<W, H>::Expand_(const OpenEntry<W, H> &entry,
+                                    Board<W, H> &scratch, Queue &queue) {
+    scratch.SetState(entry.state, entry.moves_made,
+                     entry.rank - entry.moves_made);
+    // The initial board wasn't reached by a move.
+    int inverse_of_last = (entry.node == 0) ? -1 :
+        InverseDirection((this->nodes_[entry.node] & 3) + 1);
+
+    // Make every board one move away, and score them all at once.
+    State children[4];
+    int directions[4];
+    int estimates[4];
+    int count = scratch.GetChildren(children, directions, estimates);
+    int moves_made = entry.moves_made + 1;
+    for (int i = 0; i < count; ++i) {
+        int direction = directions[i];
+        this->stats_.CountGeneration();
+        // Check if the board is at the goal state, if so then stop.
+        if (estimates[i] == 0) {
+            return this->AddNode_(entry.node, direction);
+        }
+        // Do not add the new state to the queue if the move takes back
+        // the one that made the board, which leads to its previous state.
+        // Also drop it if the state has already been reached
+        // in as few moves through some other path.
+        if (direction == inverse_of_last) {
+            this->stats_.CountParentPrune();
+        } else if (!this->closed_.Insert(children[i], moves_made)) {
+            this->stats_.CountDuplicate();
+        } else {
+            OpenEntry<W, H> child;
+            child.state = children[i];
+            child.node = this->AddNode_(entry.node, direction);
+            child.rank = moves_made + estimates[i];
+            child.moves_made = moves_made;
+            queue.push(child);
+        }
+    }
+
+    return kNoNode;
+}
+
+/**
+ * Moves a board in the directions whose new board has the same rank as
+ * the board, and puts those that haven't been reached in as few moves on
+ * the open list. Then puts the board back on the open list with the least
+ * rank of the other new boards, if there are any.
+ * @param {OpenEntry} entry The board to be expanded.
+ * @param {Board} scratch A board that is moved to make the new boards.
+ * @param {Queue} queue The open list.
+ * @return {uint32_t} a new node at the goal state, or kNoNode.
+ * @private
+ */
+template <int W, int H>
+template <class Queue>
+uint32_t AStarSearch<W, H>::ExpandPartially_(const OpenEntry<W, H> &entry,
+                                             Board<W, H> &scratch,
+                                             Queue &queue) {
+    // The rank of a board put back is more than its own, so its heuristic
+    // is worked out again.
+    scratch.SetState(entry.state, entry.moves_made);
+    // Only the first time the board comes off the open list is it counted
+    // as expanded.
+    bool first_time = entry.rank == scratch.GetRank();
+    if (first_time) {
+        this->stats_.CountExpansion(entry.rank, entry.moves_made);
+    } else {
+        this->stats_.CountReexpansion();
+    }
+    // The move that takes back the one that made the board is never tried.
+    // The initial board wasn't reached by a move.
+    int last = (entry.node == 0) ? -1 : (this->nodes_[entry.node] & 3) + 1;
+    const int blank = entry.state.blank;
+    const int count = move_tables<W, H>.operator_count[blank][last + 1];
+    const int* directions = move_tables<W, H>.operators[blank][last + 1];
+
+    State children[4];
+    int estimates[4];
+    scratch.GetChildrenInDirections(directions, count, children, estimates);
+    int moves_made = entry.moves_made + 1;
+    int next_rank = -1;
+    for (int i = 0; i < count; ++i) {
+        int rank = moves_made + estimates[i];
+        if (rank > entry.rank) {
+            // Made once the board comes off the open list with this rank.
+            if (next_rank == -1 || rank < next_rank) {
+                next_rank = rank;
+            }
+            continue;
+        }
+        // Boards with a lower rank were made when this one came off the
+        // open list before, unless this is the first time.
+        if (rank < entry.rank && !first_time) {
+            continue;
+        }
+        this->stats_.CountGeneration();
+        // Check if the board is at the goal state, if so then stop.
+        if (estimates[i] == 0) {
+            return this->AddNode_(entry.node, directions[i]);
+        }
+        if (!this->closed_.Insert(children[i], moves_made)) {
+            this->stats_.CountDuplicate();
+        } else {
+            OpenEntry<W, H> child;
+            child.state = children[i];
+            child.node = this->AddNode_(entry.node, directions[i]);
+            child.rank = rank;
+            child.moves_made = moves_made;
+            queue.push(child);
+        }
+    }
+
+    if (next_rank != -1) {
+        OpenEntry<W, H> again = entry;
+        again.rank = next_rank;
+        queue.push(again);
+    }
+    return kNoNode;
+}
+
+/**
+ * Adds a node for a board reached from a parent node.
+ * @param {uint32_t} parent The node it was reached from.
+ * @param {int} direction The direction of the move from the parent.
+ * @return {uint32_t} the index of the new node.
+ * @private
+ */
+template <int W, int H>
+uint32_t AStarSearch<W, H>::AddNode_(uint32_t parent, int direction) {
+    uint32_t index = static_cast<uint32_t>(this->nodes_.size());
+    assert(index < kMaxNodes && direction >= RIGHT && direction <= DOWN);
+    this->nodes_.push_back((parent << 2) | (direction - 1));
+    return index;
+}
+
+// The board sizes the solver supports: the 8-, 15- and 24-puzzle.
+template class AStarSearch<3, 3>;
+template class AStarSearch<4, 4>;
+template class AStarSearch<5, 5>;
@@ -0,0 +1,360 @@
+////////////////////////////////////////////////////
+// Assignment 1 : Lucas Silva                     //
+// The implementation file for the anytime search //
+////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <vector>
+#include <cassert>
+
+#include "headers/anytime_search.h"
+#include "headers/move_tables.h"
+
+namespace {
+
+/* The clock is only read once every this many boards expanded. */
+const long kClockInterval = 256;
+
+}  // namespace
+
+/**
+ * Searches for a solution from the given board, improving it for as long
+ * as the settings allow.
+ * @param {Board} board The initial board, must have been created.
+ * @return {boolean} true if a solution was found within the budget.
+ */
+template <int W, int H>
+bool AnytimeSearch<W, H>::Solve(const Board<W, H> &board) {
+    assert(board.IsValid());
+
+    this->nodes_.clear();
+    this->open_.clear();
+    this->inconsistent_.clear();
+    this->round_ = 1;
+    this->best_moves_ = -1;
+    this->bound_ = 0;
+    this->out_of_budget_ = false;
+    this->path_.clear();
+    this->improvements_.clear();
+    this->stats_ = SearchStats();
+    this->start_time_ = std::chrono::steady_clock::now();
+    if (board.IsAtGoalState()) {
+        this->bound_ = 1;
+        return true;
+    }
+
+    // A weight below 1 would give up on the bound, so it is raised to 1.
+    this->weight_ = std::max(kWeightScale, static_cast<int>(
+        std::lround(this->settings_.weight * kWeightScale)));
+    int weight_step = std::max(1, static_cast<int>(
+        std::lround(this->settings_.weight_step * kWeightScale)));
+    this->Reach_(board.GetState(), 0, board.GetEstimatedMovesRemaining(), -1);
+
+    // Every new board is found by moving this one.
+    Board<W, H> scratch(board);
+    // Until a round runs to the end, only the open list bounds a solution.
+    double proven_weight = HUGE_VAL;
+    while (true) {
+        if (!this->ImproveSolution_(scratch)) {
+            // Out of budget, but a solution found in this round still
+            // beats the one before it.
+            if (this->best_moves_ != -1) {
+                this->RecordSolution_(scratch, proven_weight);
+            }
+            break;
+        }
+        // Every state that can be reached was, without finding the goal.
+        if (this->best_moves_ == -1) {
+            break;
+        }
+        proven_weight = static_cast<double>(this->weight_) / kWeightScale;
+        this->RecordSolution_(scratch, proven_weight);
+        if (!this->settings_.improve || this->bound_ <= 1) {
+            break;
+        }
+
+        // Tighten the weight and go on from where this round stopped.
+        this->weight_ = std::max(kWeightScale, this->weight_ - weight_step);
+        this->ReorderOpenList_();
+    }
+    return this->best_moves_ != -1;
+}
+
+//////////////////////////////
+// Private helper functions //
+//////////////////////////////
+
+/**
+ * Expands boards in order of priority until nothing left on the open list
+ * could lead to a solution better than the weight allows, or the budget
+ * runs out.
+ * @param {Board} scratch A board that is moved to find the new states.
+ * @return {boolean} false if the budget ran out.
+ * @private
+ */
+template <int W, int H>
+bool AnytimeSearch<W, H>::ImproveSolution_(Board<W, H> &scratch) {
+    OpenEntryCompare compare;
+    while (!this->open_.empty()) {
+        OpenEntry current = this->open_.front();
+        std::pop_heap(this->open_.begin(), this->open_.end(), compare);
+        this->open_.pop_back();
+
+        // Skip the entry if the state was reached in fewer moves after it
+        // was put there.
+        Node &node = this->nodes_.find(current.state)->second;
+        if (!node.open || node.moves_made != current.moves_made) {
+            continue;
+        }
+        // The goal state has the lowest priority of any way to reach it,
+        // so nothing left can beat the solution by more than the weight.
+        if (this->best_moves_ != -1 &&
+            this->best_moves_ * kWeightScale <= current.priority) {
+            this->open_.push_back(current);
+            std::push_heap(this->open_.begin(), this->open_.end(), compare);
+            return true;
+        }
+        if (this->IsOverBudget_()) {
+            this->open_.push_back(current);
+            std::push_heap(this->open_.begin(), this->open_.end(), compare);
+            return false;
+        }
+
+        node.open = false;
+        node.round = this->round_;
+        int moves_made = node.moves_made;
+        int estimated_moves_remaining = node.estimated_moves_remaining;
+        int inverse_of_last = InverseDirection(node.direction);
+        this->stats_.CountExpansion(moves_made + estimated_moves_remaining,
+                                    moves_made);
+
+        scratch.SetState(current.state, moves_made,
+                         estimated_moves_remaining);
+        const int blank = current.state.blank;
+        const int move_count = move_tables<W, H>.move_count[blank];
+        for (int i = 0; i < move_count; ++i) {
+            int direction = move_tables<W, H>.moves[blank][i];
+            // Going straight back is never shorter.
+            if (direction == inverse_of_last) {
+                this->stats_.CountParentPrune();
+                continue;
+            }
+            scratch.MoveInDirection(direction);
+            this->stats_.CountGeneration();
+            State next = scratch.GetState();
+            int next_estimate = scratch.GetEstimatedMovesRemaining();
+            if (scratch.IsAtGoalState() && (this->best_moves_ == -1 ||
+                moves_made + 1 < this->best_moves_)) {
+                this->best_moves_ = moves_made + 1;
+                this->goal_state_ = next;
+            }
+            scratch.UndoMove(direction);
+            this->Reach_(next, moves_made + 1, next_estimate, direction);
+        }
+        this->stats_.UpdatePeakOpen(this->open_.size());
+    }
+    return true;
+}
+
+/**
+ * Puts a state on the open list, unless it was already reached in as few
+ * moves. If it was already expanded with the current weight, it waits for
+ * the next one instead.
+ * @param {State} state The state.
+ * @param {int} moves_made The number of moves made to reach it.
+ * @param {int} estimated_moves_remaining The heuristic of the state.
+ * @param {int} direction The direction of the move that reached it.
+ * @private
+ */
+template <int W, int H>
+void AnytimeSearch<W, H>::Reach_(const State &state, int moves_made,
+                                 int estimated_moves_remaining,
+                                 int direction) {
+    typename std::unordered_map<State, Node, StateHash>::iterator it =
+        this->nodes_.find(state);
+    if (it == this->nodes_.end()) {
+        Node fresh;
+        fresh.open = false;
+        fresh.inconsistent = false;
+        fresh.round = 0;
+        it = this->nodes_.insert(std::make_pair(state, fresh)).first;
+    } else if (it->second.moves_made <= moves_made) {
+        this->stats_.CountDuplicate();
+        return;
+    }
+
+    Node &node = it->second;
+    node.moves_made = moves_made;
+    node.estimated_moves_remaining = estimated_moves_remaining;
+    node.direction = direction;
+    if (node.round == this->round_) {
+        // Expanded with this weight already, so it waits for the next.
+        if (!node.inconsistent) {
+            node.inconsistent = true;
+            this->inconsistent_.push_back(state);
+        }
+        return;
+    }
+
+    node.open = true;
+    OpenEntry entry;
+    entry.priority = this->Priority_(moves_made, estimated_moves_remaining);
+    entry.moves_made = moves_made;
+    entry.state = state;
+    this->open_.push_back(entry);
+    std::push_heap(this->open_.begin(), this->open_.end(),
+                   OpenEntryCompare());
+}
+
+/**
+ * Starts the next round: moves the states waiting for it onto the open
+ * list, and orders the open list again with the current weight.
+ * @private
+ */
+template <int W, int H>
+void AnytimeSearch<W, H>::ReorderOpenList_() {
+    // Drop the entries that were improved on, and weigh the rest again.
+    size_t kept = 0;
+    for (size_t i = 0; i < this->open_.size(); ++i) {
+        OpenEntry entry = this->open_[i];
+        const Node &node = this->nodes_.find(entry.state)->second;
+        if (!node.open || node.moves_made != entry.moves_made) {
+            continue;
+        }
+        entry.priority = this->Priority_(node.moves_made,
+                                         node.estimated_moves_remaining);
+        this->open_[kept++] = entry;
+    }
+    this->open_.resize(kept);
+
+    for (size_t i = 0; i < this->inconsistent_.size(); ++i) {
+        Node &node = this->nodes_.find(this->inconsistent_[i])->second;
+        node.inconsistent = false;
+        node.open = true;
+        OpenEntry entry;
+        entry.priority = this->Priority_(node.moves_made,
+                                         node.estimated_moves_remaining);
+        entry.moves_made = node.moves_made;
+        entry.state = this->inconsistent_[i];
+        this->open_.push_back(entry);
+    }
+    this->inconsistent_.clear();
+
+    std::make_heap(this->open_.begin(), this->open_.end(),
+                   OpenEntryCompare());
+    ++this->round_;
+}
+
+/**
+ * Gets the bound of the best solution: its length over the lowest rank of
+ * any state on the open list or waiting for the next round, which no
+ * solution can be shorter than.
+ * @param {double} proven_weight The weight of the last round that ran to
+ *   the end, which also bounds the solution.
+ * @return {double} the bound, at most proven_weight.
+ * @private
+ */
+template <int W, int H>
+double AnytimeSearch<W, H>::CalculateBound_(double proven_weight) const {
+    int lowest_rank = -1;
+    for (size_t i = 0; i < this->open_.size(); ++i) {
+        const Node &node = this->nodes_.find(this->open_[i].state)->second;
+        if (!node.open || node.moves_made != this->open_[i].moves_made) {
+            continue;
+        }
+        int rank = node.moves_made + node.estimated_moves_remaining;
+        if (lowest_rank == -1 || rank < lowest_rank) {
+            lowest_rank = rank;
+        }
+    }
+    for (size_t i = 0; i < this->inconsistent_.size(); ++i) {
+        const Node &node = this->nodes_.find(this->inconsistent_[i])->second;
+        int rank = node.moves_made + node.estimated_moves_remaining;
+        if (lowest_rank == -1 || rank < lowest_rank) {
+            lowest_rank = rank;
+        }
+    }
+
+    // With nothing left to expand, no shorter solution exists.
+    double bound = 1;
+    if (lowest_rank > 0) {
+        bound = std::max(1.0, static_cast<double>(this->path_.size()) /
+                         lowest_rank);
+    }
+    return std::min(bound, proven_weight);
+}
+
+/**
+ * Checks if the search has used up its time or boards.
+ * @return {boolean} true if the budget ran out.
+ * @private
+ */
+template <int W, int H>
+bool AnytimeSearch<W, H>::IsOverBudget_() {
+    long expanded = this->stats_.expanded;
+    if (this->settings_.node_limit > 0 &&
+        expanded >= this->settings_.node_limit) {
+        this->out_of_budget_ = true;
+    } else if (this->settings_.time_limit_ms > 0 &&
+               expanded % kClockInterval == 0) {
+        std::chrono::duration<double, std::milli> elapsed =
+            std::chrono::steady_clock::now() - this->start_time_;
+        if (elapsed.count() >= this->settings_.time_limit_ms) {
+            this->out_of_budget_ = true;
+        }
+    }
+    return this->out_of_budget_;
+}
+
+/**
+ * Follows the moves back from the goal state to the initial board, and
+ * keeps the solution with its bound.
+ * @param {Board} scratch A board that is moved to follow the moves.
+ * @param {double} proven_weight The weight of the last round that ran to
+ *   the end.
+ * @private
+ */
+template <int W, int H>
+void AnytimeSearch<W, H>::RecordSolution_(Board<W, H> &scratch,
+                                          double proven_weight) {
+    // A state's previous state always has fewer moves than it, so this
+    // ends, and the path is no longer than the moves made to the goal.
+    this->path_.clear();
+    State state = this->goal_state_;
+    while (true) {
+        const Node &node = this->nodes_.find(state)->second;
+        if (node.direction == -1) {
+            break;
+        }
+        this->path_.push_back(node.direction);
+        scratch.SetState(state, node.moves_made);
+        scratch.UndoMove(node.direction);
+        state = scratch.GetState();
+    }
+    this->path_.Reverse();
+    this->bound_ = this->CalculateBound_(proven_weight);
+
+    Improvement improvement;
+    improvement.moves = static_cast<int>(this->path_.size());
+    improvement.bound = this->bound_;
+    std::chrono::duration<double, std::milli> elapsed =
+        std::chrono::steady_clock::now() - this->start_time_;
+    improvement.wall_ms = elapsed.count();
+    improvement.expanded = this->stats_.expanded;
+    if (this->improvements_.empty() ||
+        improvement.moves < this->improvements_.back().moves ||
+        improvement.bound < this->improvements_.back().bound) {
+        this->improvements_.push_back(improvement);
+    }
+}
+
+// std::max takes the scale by reference, so it needs a definition.
+template <int W, int H>
+const int AnytimeSearch<W, H>::kWeightScale;
+
+// The board sizes the solver supports: the 8-, 15- and 24-puzzle.
+template class AnytimeSearch<3, 3>;
+template class AnytimeSearch<4, 4>;
+template class AnytimeSearch<5, 5>;
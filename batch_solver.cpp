@@ -0,0 +1,224 @@
+//////////////////////////////////////////////////
+// Assignment 1 : Lucas Silva                   //
+// The implementation file for the batch solver //
+//////////////////////////////////////////////////
+
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "headers/batch_solver.h"
+#include "headers/solver.h"
+
+namespace {
+
+/**
+ * Removes white space from both ends of a line.
+ * @param {string} line The line.
+ * @return {string} the line without leading or trailing white space.
+ */
+std::string Trim(const std::string &line) {
+    size_t first = line.find_first_not_of(" \t\r\n");
+    if (first == std::string::npos) {
+        return "";
+    }
+    size_t last = line.find_last_not_of(" \t\r\n");
+    return line.substr(first, last - first + 1);
+}
+
+}  // namespace
+
+/**
+ * Reads the boards from a stream.
+ * @param {istream} in The stream to read from.
+ * @param {vector<string>} names Filled with a name for each board.
+ * @param {vector<string>} inputs Filled with the tiles of each board.
+ */
+void BatchSolver::ReadBoards(std::istream &in,
+                             std::vector<std::string> &names,
+                             std::vector<std::string> &inputs) {
+    std::vector<std::string> lines;
+    std::string line;
+    bool is_test_case_layout = false;
+    while (std::getline(in, line)) {
+        lines.push_back(Trim(line));
+        if (lines.back() == "Input:") {
+            is_test_case_layout = true;
+        }
+    }
+
+    if (!is_test_case_layout) {
+        for (size_t i = 0; i < lines.size(); ++i) {
+            if (!lines[i].empty()) {
+                std::ostringstream name;
+                name << "Board " << names.size() + 1;
+                names.push_back(name.str());
+                inputs.push_back(lines[i]);
+            }
+        }
+        return;
+    }
+
+    // The rows of a board follow "Input:", up to "Output:", a blank line
+    // or the next case.
+    std::string name;
+    for (size_t i = 0; i < lines.size(); ++i) {
+        if (lines[i].compare(0, 5, "Case ") == 0) {
+            name = lines[i].substr(0, lines[i].find_last_not_of(':') + 1);
+            continue;
+        }
+        if (lines[i] != "Input:") {
+            continue;
+        }
+        std::string tiles;
+        while (i + 1 < lines.size() && !lines[i + 1].empty() &&
+               lines[i + 1] != "Output:" &&
+               lines[i + 1].compare(0, 5, "Case ") != 0) {
+            ++i;
+            tiles += (tiles.empty() ? "" : " ") + lines[i];
+        }
+        if (name.empty()) {
+            std::ostringstream number;
+            number << "Case " << names.size() + 1;
+            name = number.str();
+        }
+        names.push_back(name);
+        inputs.push_back(tiles);
+        name.clear();
+    }
+}
+
+/**
+ * Solves every board read from a stream, and writes a line for each one
+ * in the same order.
+ * @param {istream} in The stream to read the boards from.
+ * @param {ostream} out The stream to write the results to.
+ * @return {int} the number of boards solved.
+ */
+int BatchSolver::Run(std::istream &in, std::ostream &out) {
+    this->names_.clear();
+    this->inputs_.clear();
+    ReadBoards(in, this->names_, this->inputs_);
+    size_t boards = this->inputs_.size();
+    this->results_.assign(boards, "");
+    this->finished_.assign(boards, false);
+    this->out_ = &out;
+    this->next_to_write_ = 0;
+    this->solved_ = 0;
+
+    // No point in more threads than boards.
+    int threads = this->threads_ < 1 ? 1 : this->threads_;
+    if (boards > 0 && static_cast<size_t>(threads) > boards) {
+        threads = static_cast<int>(boards);
+    }
+
+    // Deal the boards out in turn, so hard boards next to each other in
+    // the input end up on different threads.
+    for (int i = 0; i < threads; ++i) {
+        this->queues_.push_back(new WorkQueue());
+    }
+    for (size_t i = 0; i < boards; ++i) {
+        this->queues_[i % threads]->boards.push_back(i);
+    }
+
+    std::vector<std::thread> workers;
+    for (int i = 1; i < threads; ++i) {
+        workers.push_back(std::thread(&BatchSolver::Work_, this, i));
+    }
+    // This thread is the first worker.
+    this->Work_(0);
+    for (size_t i = 0; i < workers.size(); ++i) {
+        workers[i].join();
+    }
+
+    for (size_t i = 0; i < this->queues_.size(); ++i) {
+        delete this->queues_[i];
+        this->queues_[i] = NULL;
+    }
+    this->queues_.clear();
+    out.flush();
+    return this->solved_;
+}
+
+//////////////////////////////
+// Private helper functions //
+//////////////////////////////
+
+/**
+ * Solves boards until every queue is empty.
+ * @param {int} thread The index of the thread, and of its own queue.
+ * @private
+ */
+void BatchSolver::Work_(int thread) {
+    // The searches of this thread, kept from one board to the next.
+    Solver solver(&this->table_, this->cache_);
+    SolveResult result;
+    size_t board;
+    while (this->TakeBoard_(thread, board)) {
+        bool solved = solver.Solve(this->inputs_[board], this->options_,
+                                   result);
+        std::ostringstream line;
+        Solver::WriteResult(result, line);
+        this->Finish_(board, line.str(), solved);
+    }
+}
+
+/**
+ * Takes the next board for a thread, from the front of its own queue,
+ * or else from the back of another thread's queue.
+ * @param {int} thread The index of the thread.
+ * @param {size_t} board Set to the index of the board taken.
+ * @return {boolean} false if every queue is empty.
+ * @private
+ */
+bool BatchSolver::TakeBoard_(int thread, size_t &board) {
+    int threads = static_cast<int>(this->queues_.size());
+    for (int i = 0; i < threads; ++i) {
+        int victim = (thread + i) % threads;
+        WorkQueue* queue = this->queues_[victim];
+        std::lock_guard<std::mutex> lock(queue->mutex);
+        if (queue->boards.empty()) {
+            continue;
+        }
+        // Our own boards are taken in order, stolen ones from the far end.
+        if (victim == thread) {
+            board = queue->boards.front();
+            queue->boards.pop_front();
+        } else {
+            board = queue->boards.back();
+            queue->boards.pop_back();
+        }
+        return true;
+    }
+    // Boards are never added once solving starts, so this thread is done.
+    return false;
+}
+
+/**
+ * Stores the result of a board, and writes every result that is next
+ * in order.
+ * @param {size_t} board The index of the board.
+ * @param {string} result The line of result, without the name.
+ * @param {boolean} solved true if the board was solved.
+ * @private
+ */
+void BatchSolver::Finish_(size_t board, const std::string &result,
+                          bool solved) {
+    std::lock_guard<std::mutex> lock(this->results_mutex_);
+    this->results_[board] = result;
+    this->finished_[board] = true;
+    if (solved) {
+        ++this->solved_;
+    }
+    while (this->next_to_write_ < this->results_.size() &&
+           this->finished_[this->next_to_write_]) {
+        size_t next = this->next_to_write_++;
+        *this->out_ << this->names_[next] << ": " << this->results_[next];
+        *this->out_ << std::endl;
+        // The result is written, so its memory can go.
+        std::string().swap(this->results_[next]);
+    }
+}
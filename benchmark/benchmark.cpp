@@ -0,0 +1,630 @@
+///////////////////////////////////
+// Assignment 1 : Lucas Silva    //
+// The benchmark of the searches //
+///////////////////////////////////
+
+#include <sys/resource.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../headers/board.h"
+#include "../headers/a_star_search.h"
+#include "../headers/batch_solver.h"
+#include "../headers/bidirectional_search.h"
+#include "../headers/distance_table.h"
+#include "../headers/hda_star.h"
+#include "../headers/ida_star.h"
+#include "../headers/pattern_database.h"
+#include "../headers/perf_counters.h"
+#include "../headers/solver.h"
+
+#define RIGHT 1
+#define LEFT 2
+#define UP 3
+#define DOWN 4
+
+#define MANHATTAN 1        // Sum of manhattan distances
+#define LINEAR_CONFLICT 2  // Manhattan distances plus linear conflicts
+#define PATTERN_DATABASE 3 // Additive pattern database
+
+// The test cases every run starts with.
+#define TEST_CASES_FILE "tests/HW1_Testcases_Student.dat"
+
+/* A board to be solved, and where it came from. */
+struct Instance {
+    /* "testcases" for the test case file, "generated" otherwise. */
+    std::string set;
+    /* The name of the board within its set. */
+    std::string name;
+    /* The range of optimal depths it was generated for, or empty. */
+    std::string bucket;
+    /* The tiles of the board, as the user would enter them. */
+    std::string tiles;
+    /* The number of tiles, which decides the size of the board. */
+    int tile_count;
+    /* The number of moves of a shortest solution, -1 if not known. */
+    int depth;
+};
+
+/* What one search did on one board. */
+struct Result {
+    bool solved;
+    int moves;
+    double wall_ms;
+    long nodes_expanded;
+    long nodes_generated;
+    /* -1 for searches without an open list. */
+    long peak_open;
+    long peak_rss_kb;
+    /* The hardware counters of the search, -1 if not counted. */
+    long long counters[PerfCounters::kEvents];
+};
+
+/* The name of each search, indexed by the search. */
+const char* SEARCH_NAMES[9] = {"", "heap", "buckets", "ida", "", "hda",
+                               "bidirectional", "", "epea"};
+
+/* The name of each heuristic, indexed by the heuristic. */
+const char* HEURISTIC_NAMES[4] = {"", "manhattan", "linear-conflict", "pdb"};
+
+/* The ranges of optimal depths the generated boards are picked from. */
+const int DEPTH_BUCKETS_3X3[][2] = {{0, 9}, {10, 14}, {15, 19}, {20, 24},
+                                    {25, 31}};
+const int DEPTH_BUCKETS_4X4[][2] = {{10, 19}, {20, 29}, {30, 39}};
+
+/**
+ * Forgets the peak resident memory of the process so far, so the next
+ * reading only covers what comes after. Only Linux can do this.
+ */
+void ResetPeakMemory() {
+    std::ofstream clear_refs("/proc/self/clear_refs");
+    if (clear_refs) {
+        clear_refs << "5";
+    }
+}
+
+/**
+ * Gets the peak resident memory of the process since it was last reset.
+ * @return {long} the peak resident memory, in kB.
+ */
+long GetPeakMemoryKb() {
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.compare(0, 6, "VmHWM:") == 0) {
+            return std::atol(line.c_str() + 6);
+        }
+    }
+    // Without /proc, the peak of the whole run is the best there is.
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+/**
+ * Makes a board by moving the empty space of the goal state about at
+ * random, never straight back.
+ * @param {int} width The width of the board.
+ * @param {int} height The height of the board.
+ * @param {int} moves The number of moves to make.
+ * @param {mt19937} random The random number generator.
+ * @return {string} the tiles of the board.
+ */
+std::string MakeRandomWalk(int width, int height, int moves,
+                           std::mt19937 &random) {
+    int cells = width * height;
+    std::vector<int> tiles(cells);
+    for (int i = 0; i < cells; ++i) {
+        tiles[i] = (i + 1) % cells;
+    }
+    int blank = cells - 1;
+    int last = -1;
+    for (int i = 0; i < moves; ++i) {
+        int row = blank / width;
+        int column = blank % width;
+        std::vector<int> cells_next_to_blank;
+        if (column + 1 < width && last != blank + 1) {
+            cells_next_to_blank.push_back(blank + 1);
+        }
+        if (column > 0 && last != blank - 1) {
+            cells_next_to_blank.push_back(blank - 1);
+        }
+        if (row + 1 < height && last != blank + width) {
+            cells_next_to_blank.push_back(blank + width);
+        }
+        if (row > 0 && last != blank - width) {
+            cells_next_to_blank.push_back(blank - width);
+        }
+        int next = cells_next_to_blank[random() % cells_next_to_blank.size()];
+        tiles[blank] = tiles[next];
+        tiles[next] = 0;
+        last = blank;
+        blank = next;
+    }
+
+    std::ostringstream input;
+    for (int i = 0; i < cells; ++i) {
+        input << (i ? " " : "") << tiles[i];
+    }
+    return input.str();
+}
+
+/**
+ * Gets the number of moves of a shortest solution of an 8-puzzle.
+ * @param {string} tiles The tiles of the board.
+ * @param {DistanceTable} table The distance table.
+ * @return {int} the number of moves, -1 if it cannot be solved.
+ */
+int GetDepth3x3(const std::string &tiles, const DistanceTable &table) {
+    Board<3, 3> board(tiles);
+    if (!board.CreateBoard() || !board.IsSolvable()) {
+        return -1;
+    }
+    return table.GetDistance(board);
+}
+
+/**
+ * Gets the number of moves of a shortest solution of a 15-puzzle, with
+ * IDA* and the linear conflicts.
+ * @param {string} tiles The tiles of the board.
+ * @return {int} the number of moves, -1 if it cannot be solved.
+ */
+int GetDepth4x4(const std::string &tiles) {
+    // Set before the board is created, so its own estimate counts the
+    // linear conflicts too.
+    Board<4, 4>::SetLinearConflict(true);
+    int depth = -1;
+    Board<4, 4> board(tiles);
+    if (board.CreateBoard() && board.IsSolvable()) {
+        IdaStarSearch<4, 4> search;
+        if (search.Solve(board)) {
+            depth = static_cast<int>(search.GetPath().size());
+        }
+    }
+    Board<4, 4>::SetLinearConflict(false);
+    return depth;
+}
+
+/**
+ * Generates boards until every bucket of optimal depths has its share.
+ * @param {int} width The width of the boards.
+ * @param {int} height The height of the boards.
+ * @param {int[][2]} buckets The lowest and highest depth of each bucket.
+ * @param {int} bucket_count The number of buckets.
+ * @param {int} per_bucket The number of boards for each bucket.
+ * @param {int} max_walk The longest random walk to make a board from.
+ * @param {DistanceTable} table The distance table, for the 8-puzzle.
+ * @param {mt19937} random The random number generator.
+ * @param {vector<Instance>} instances The boards are added to this.
+ */
+void GenerateInstances(int width, int height, const int buckets[][2],
+                       int bucket_count, int per_bucket, int max_walk,
+                       const DistanceTable &table, std::mt19937 &random,
+                       std::vector<Instance> &instances) {
+    std::vector<int> found(bucket_count, 0);
+    int missing = bucket_count * per_bucket;
+    // Some buckets may be very hard to hit, so give up after a while.
+    for (int tries = 0; missing > 0 && tries < 100000; ++tries) {
+        std::string tiles = MakeRandomWalk(width, height,
+                                           random() % (max_walk + 1), random);
+        int depth = (width * height == 9) ? GetDepth3x3(tiles, table) :
+            GetDepth4x4(tiles);
+        for (int i = 0; i < bucket_count; ++i) {
+            if (depth < buckets[i][0] || depth > buckets[i][1] ||
+                found[i] == per_bucket) {
+                continue;
+            }
+            std::ostringstream bucket;
+            bucket << width * height - 1 << "-puzzle depth " << buckets[i][0];
+            bucket << "-" << buckets[i][1];
+            std::ostringstream name;
+            name << bucket.str() << " #" << ++found[i];
+
+            Instance instance;
+            instance.set = "generated";
+            instance.name = name.str();
+            instance.bucket = bucket.str();
+            instance.tiles = tiles;
+            instance.tile_count = width * height;
+            instance.depth = depth;
+            instances.push_back(instance);
+            --missing;
+        }
+    }
+    if (missing > 0) {
+        std::cerr << "Only generated " << bucket_count * per_bucket - missing;
+        std::cerr << " of " << bucket_count * per_bucket << " ";
+        std::cerr << width * height - 1 << "-puzzle boards" << std::endl;
+    }
+}
+
+/**
+ * Solves a board with one of the searches, and measures how long it took
+ * and how much work was done. A solution only counts if replaying its moves
+ * takes the board to its goal state.
+ * @param {string} tiles The tiles of the board.
+ * @param {int} search The search to use.
+ * @param {int} threads The number of threads, used by HDA_STAR_SEARCH.
+ * @param {boolean} count_events true to read the hardware counters too.
+ * @param {Result} result Filled with the measurements.
+ * @return {boolean} false if the board could not be created or solved.
+ */
+template <int W, int H>
+bool RunSearch(const std::string &tiles, int search, int threads,
+               bool count_events, Result &result) {
+    Board<W, H> board(tiles);
+    if (!board.CreateBoard() || !board.IsSolvable()) {
+        return false;
+    }
+
+    result.peak_open = -1;
+    for (int i = 0; i < PerfCounters::kEvents; ++i) {
+        result.counters[i] = -1;
+    }
+    // The counters are opened before the search, so they count its threads.
+    PerfCounters* perf = NULL;
+    if (count_events) {
+        perf = new PerfCounters(std::vector<std::string>(1, "search"));
+    }
+    ResetPeakMemory();
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    if (perf) {
+        perf->Start(0);
+    }
+    switch (search) {
+        case IDA_STAR_SEARCH: {
+            IdaStarSearch<W, H> ida_star;
+            result.solved = ida_star.Solve(board) &&
+                board.IsSolvedBy(ida_star.GetPath());
+            result.moves = ida_star.GetPath().size();
+            result.nodes_expanded = ida_star.GetStats().expanded;
+            result.nodes_generated = ida_star.GetStats().generated;
+            break;
+        }
+        case HDA_STAR_SEARCH: {
+            HdaStarSearch<W, H> hda_star(threads);
+            result.solved = hda_star.Solve(board) &&
+                board.IsSolvedBy(hda_star.GetPath());
+            result.moves = hda_star.GetPath().size();
+            SearchStats stats = hda_star.GetStats();
+            result.nodes_expanded = stats.expanded;
+            result.nodes_generated = stats.generated;
+            result.peak_open = stats.peak_open;
+            break;
+        }
+        case BIDIRECTIONAL_SEARCH: {
+            BidirectionalSearch<W, H> bidirectional;
+            result.solved = bidirectional.Solve(board) &&
+                board.IsSolvedBy(bidirectional.GetPath());
+            result.moves = bidirectional.GetPath().size();
+            result.nodes_expanded = bidirectional.GetStats().expanded;
+            result.nodes_generated = bidirectional.GetStats().generated;
+            result.peak_open = bidirectional.GetStats().peak_open;
+            break;
+        }
+        default: {
+            // EPEA* keeps its open list in buckets, like '--epea'.
+            AStarSearch<W, H> a_star(search != HEAP_SEARCH,
+                                     search == PARTIAL_EXPANSION_SEARCH);
+            result.solved = a_star.Solve(board) &&
+                board.IsSolvedBy(a_star.GetPath());
+            result.moves = a_star.GetPath().size();
+            result.nodes_expanded = a_star.GetStats().expanded;
+            result.nodes_generated = a_star.GetStats().generated;
+            result.peak_open = a_star.GetStats().peak_open;
+            break;
+        }
+    }
+    if (perf) {
+        perf->Stop();
+    }
+    std::chrono::duration<double, std::milli> elapsed =
+        std::chrono::steady_clock::now() - start;
+    result.wall_ms = elapsed.count();
+    result.peak_rss_kb = GetPeakMemoryKb();
+    if (perf) {
+        for (int i = 0; i < PerfCounters::kEvents; ++i) {
+            result.counters[i] = perf->GetReading(0).counts[i];
+        }
+        delete perf;
+    }
+    return result.solved;
+}
+
+/**
+ * Sets the heuristic used by every board of a size, loading the pattern
+ * database from the file --build-pdb saved it to.
+ * @param {int} heuristic MANHATTAN, LINEAR_CONFLICT or PATTERN_DATABASE.
+ * @param {PatternDatabase} database Loaded for PATTERN_DATABASE.
+ * @return {boolean} false if the pattern database could not be loaded.
+ */
+template <int W, int H>
+bool SetHeuristic(int heuristic, PatternDatabase<W, H> &database) {
+    Board<W, H>::SetLinearConflict(heuristic == LINEAR_CONFLICT);
+    Board<W, H>::SetPatternDatabase(NULL);
+    if (heuristic != PATTERN_DATABASE) {
+        return true;
+    }
+
+    std::ostringstream file;
+    file << W * H - 1 << "puzzle_pdb.bin";
+    if (!database.Load(file.str())) {
+        std::cerr << "Could not load " << file.str();
+        std::cerr << ", run the solver with --build-pdb first" << std::endl;
+        return false;
+    }
+    Board<W, H>::SetPatternDatabase(&database);
+    return true;
+}
+
+/**
+ * Puts a string in double quotes, escaped for JSON. The names and tiles
+ * written never hold quotes, so the same works for CSV.
+ * @param {string} text The string.
+ * @return {string} the quoted string.
+ */
+std::string Quote(const std::string &text) {
+    std::string quoted = "\"";
+    for (size_t i = 0; i < text.size(); ++i) {
+        if (text[i] == '"' || text[i] == '\\') {
+            quoted += '\\';
+        }
+        quoted += text[i];
+    }
+    return quoted + "\"";
+}
+
+/**
+ * Writes the header line of the CSV output.
+ * @param {ostream} out The stream to write to.
+ */
+void WriteCsvHeader(std::ostream &out) {
+    out << "set,instance,bucket,tiles,size,depth,search,heuristic,solved,";
+    out << "moves,wall_ms,nodes_expanded,nodes_generated,nodes_per_second,";
+    out << "peak_open,peak_rss_kb";
+    for (int i = 0; i < PerfCounters::kEvents; ++i) {
+        out << "," << PerfCounters::kEventNames[i];
+    }
+    out << std::endl;
+}
+
+/**
+ * Writes the measurements of one search on one board, as a line of CSV
+ * or as a JSON object. Values that aren't known are left empty in CSV
+ * and are null in JSON.
+ * @param {ostream} out The stream to write to.
+ * @param {boolean} json true for JSON, false for CSV.
+ * @param {Instance} instance The board.
+ * @param {int} search The search used.
+ * @param {int} heuristic The heuristic used.
+ * @param {Result} result The measurements.
+ */
+void WriteResult(std::ostream &out, bool json, const Instance &instance,
+                 int search, int heuristic, const Result &result) {
+    double nodes_per_second = result.wall_ms > 0 ?
+        result.nodes_expanded / (result.wall_ms / 1000.0) : 0.0;
+    std::string unknown = json ? "null" : "";
+    std::vector<std::pair<std::string, std::string> > fields;
+    fields.push_back(std::make_pair("set", Quote(instance.set)));
+    fields.push_back(std::make_pair("instance", Quote(instance.name)));
+    fields.push_back(std::make_pair("bucket", instance.bucket.empty() ?
+                                    unknown : Quote(instance.bucket)));
+    fields.push_back(std::make_pair("tiles", Quote(instance.tiles)));
+    fields.push_back(std::make_pair("size",
+                                    std::to_string(instance.tile_count - 1)));
+    fields.push_back(std::make_pair("depth", instance.depth == -1 ?
+                                    unknown : std::to_string(instance.depth)));
+    fields.push_back(std::make_pair("search", Quote(SEARCH_NAMES[search])));
+    fields.push_back(std::make_pair("heuristic",
+                                    Quote(HEURISTIC_NAMES[heuristic])));
+    fields.push_back(std::make_pair("solved",
+                                    result.solved ? "true" : "false"));
+    fields.push_back(std::make_pair("moves", std::to_string(result.moves)));
+    fields.push_back(std::make_pair("wall_ms",
+                                    std::to_string(result.wall_ms)));
+    fields.push_back(std::make_pair("nodes_expanded",
+                                    std::to_string(result.nodes_expanded)));
+    fields.push_back(std::make_pair("nodes_generated",
+                                    std::to_string(result.nodes_generated)));
+    fields.push_back(std::make_pair("nodes_per_second",
+        std::to_string(static_cast<long>(nodes_per_second))));
+    fields.push_back(std::make_pair("peak_open", result.peak_open == -1 ?
+                                    unknown :
+                                    std::to_string(result.peak_open)));
+    fields.push_back(std::make_pair("peak_rss_kb",
+                                    std::to_string(result.peak_rss_kb)));
+    for (int i = 0; i < PerfCounters::kEvents; ++i) {
+        fields.push_back(std::make_pair(PerfCounters::kEventNames[i],
+            result.counters[i] == -1 ? unknown :
+            std::to_string(result.counters[i])));
+    }
+
+    for (size_t i = 0; i < fields.size(); ++i) {
+        if (json) {
+            out << (i ? ", " : "  {") << Quote(fields[i].first) << ": ";
+        } else if (i) {
+            out << ",";
+        }
+        out << fields[i].second;
+    }
+    if (json) {
+        out << "}";
+    }
+}
+
+/**
+ * Prints how to run the benchmark.
+ * @param {char*} program The name the program was run as.
+ */
+void PrintUsage(const char* program) {
+    std::cerr << "Usage: " << program;
+    std::cerr << " [--search heap|buckets|ida|hda|bidirectional|epea]...";
+    std::cerr << std::endl;
+    std::cerr << "           [--linear-conflict | --pdb] [--csv]";
+    std::cerr << " [--threads N] [--perf]" << std::endl;
+    std::cerr << "           [--cases FILE] [--per-bucket N] [--seed N]";
+    std::cerr << std::endl;
+}
+
+///////////////////
+// Start of main //
+///////////////////
+
+int main(int argc, char* argv[]) {
+    std::vector<int> searches;
+    int heuristic = MANHATTAN;
+    bool json = true;
+    int threads = 4;
+    const char* cases_file = TEST_CASES_FILE;
+    int per_bucket = 3;
+    unsigned int seed = 1;
+    bool count_events = false;
+    for (int i = 1; i < argc; ++i) {
+        bool has_value = i + 1 < argc;
+        if (std::strcmp(argv[i], "--search") == 0 && has_value) {
+            ++i;
+            int search = -1;
+            for (int j = 0; j < 9; ++j) {
+                if (SEARCH_NAMES[j][0] &&
+                    std::strcmp(argv[i], SEARCH_NAMES[j]) == 0) {
+                    search = j;
+                }
+            }
+            if (search == -1) {
+                std::cerr << "Unknown search: " << argv[i] << std::endl;
+                return 1;
+            }
+            searches.push_back(search);
+        } else if (std::strcmp(argv[i], "--linear-conflict") == 0) {
+            heuristic = LINEAR_CONFLICT;
+        } else if (std::strcmp(argv[i], "--pdb") == 0) {
+            heuristic = PATTERN_DATABASE;
+        } else if (std::strcmp(argv[i], "--csv") == 0) {
+            json = false;
+        } else if (std::strcmp(argv[i], "--perf") == 0) {
+            count_events = true;
+        } else if (std::strcmp(argv[i], "--threads") == 0 && has_value &&
+                   std::atoi(argv[i + 1]) > 0) {
+            threads = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--cases") == 0 && has_value) {
+            cases_file = argv[++i];
+        } else if (std::strcmp(argv[i], "--per-bucket") == 0 && has_value &&
+                   std::atoi(argv[i + 1]) >= 0) {
+            per_bucket = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--seed") == 0 && has_value) {
+            seed = std::strtoul(argv[++i], NULL, 10);
+        } else {
+            std::cerr << "Unknown option: " << argv[i] << std::endl;
+            PrintUsage(argv[0]);
+            return 1;
+        }
+    }
+    if (searches.empty()) {
+        searches.push_back(HEAP_SEARCH);
+        searches.push_back(BUCKET_SEARCH);
+        searches.push_back(IDA_STAR_SEARCH);
+        searches.push_back(HDA_STAR_SEARCH);
+        searches.push_back(BIDIRECTIONAL_SEARCH);
+        searches.push_back(PARTIAL_EXPANSION_SEARCH);
+    }
+
+    // The test cases first, then boards generated for each range of depths.
+    std::vector<Instance> instances;
+    std::ifstream cases(cases_file);
+    if (!cases) {
+        std::cerr << "Could not open " << cases_file << std::endl;
+        return 1;
+    }
+    std::vector<std::string> names;
+    std::vector<std::string> inputs;
+    BatchSolver::ReadBoards(cases, names, inputs);
+
+    // Every 8-puzzle depth is a lookup in the distance table.
+    DistanceTable table;
+    table.Build();
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        Instance instance;
+        instance.set = "testcases";
+        instance.name = names[i];
+        instance.tiles = inputs[i];
+        std::vector<int> tiles;
+        ParseTiles(inputs[i], tiles);
+        instance.tile_count = tiles.size();
+        instance.depth = (tiles.size() == 9) ?
+            GetDepth3x3(inputs[i], table) : -1;
+        instances.push_back(instance);
+    }
+
+    std::mt19937 random(seed);
+    GenerateInstances(3, 3, DEPTH_BUCKETS_3X3, 5, per_bucket, 80, table,
+                      random, instances);
+    GenerateInstances(4, 4, DEPTH_BUCKETS_4X4, 3, per_bucket, 60, table,
+                      random, instances);
+
+    PatternDatabase<3, 3> database_3x3;
+    PatternDatabase<4, 4> database_4x4;
+    PatternDatabase<5, 5> database_5x5;
+    if (!SetHeuristic(heuristic, database_3x3) ||
+        !SetHeuristic(heuristic, database_4x4) ||
+        !SetHeuristic(heuristic, database_5x5)) {
+        return 1;
+    }
+
+    if (json) {
+        std::cout << "[" << std::endl;
+    } else {
+        WriteCsvHeader(std::cout);
+    }
+    bool first = true;
+    for (size_t i = 0; i < instances.size(); ++i) {
+        for (size_t j = 0; j < searches.size(); ++j) {
+            Result result = Result();
+            bool created;
+            switch (instances[i].tile_count) {
+                case 16:
+                    created = RunSearch<4, 4>(instances[i].tiles, searches[j],
+                                              threads, count_events, result);
+                    break;
+                case 25:
+                    created = RunSearch<5, 5>(instances[i].tiles, searches[j],
+                                              threads, count_events, result);
+                    break;
+                case 9:
+                    created = RunSearch<3, 3>(instances[i].tiles, searches[j],
+                                              threads, count_events, result);
+                    break;
+                default:
+                    created = false;
+                    break;
+            }
+            if (!created) {
+                std::cerr << "Skipping " << instances[i].name;
+                std::cerr << ", it could not be solved" << std::endl;
+                break;
+            }
+            if (json && !first) {
+                std::cout << "," << std::endl;
+            }
+            first = false;
+            WriteResult(std::cout, json, instances[i], searches[j], heuristic,
+                        result);
+            if (!json) {
+                std::cout << std::endl;
+            }
+        }
+    }
+    if (json) {
+        std::cout << std::endl << "]" << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,185 @@
+//////////////////////////////////////////////
+// Assignment 1 : Lucas Silva               //
+// The benchmark of the heuristic kernel    //
+//////////////////////////////////////////////
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../headers/board.h"
+#include "../headers/heuristic_kernel.h"
+
+// How many times every state is scored, so each timing is long enough.
+#define DEFAULT_ROUNDS 200
+
+// How many states are scored at once when scoring a frontier.
+#define FRONTIER_BATCH 1024
+
+/**
+ * Makes a board by moving the empty space of the goal state about at
+ * random, never straight back.
+ * @param {int} moves The number of moves to make.
+ * @param {mt19937} random The random number generator.
+ * @return {string} the tiles of the board.
+ */
+template <int W, int H>
+std::string MakeRandomWalk(int moves, std::mt19937 &random) {
+    const int cells = W * H;
+    std::vector<int> tiles(cells);
+    for (int i = 0; i < cells; ++i) {
+        tiles[i] = (i + 1) % cells;
+    }
+    int blank = cells - 1;
+    int last = -1;
+    for (int i = 0; i < moves; ++i) {
+        int row = blank / W;
+        int column = blank % W;
+        std::vector<int> next_cells;
+        if (column + 1 < W && last != blank + 1) {
+            next_cells.push_back(blank + 1);
+        }
+        if (column > 0 && last != blank - 1) {
+            next_cells.push_back(blank - 1);
+        }
+        if (row + 1 < H && last != blank + W) {
+            next_cells.push_back(blank + W);
+        }
+        if (row > 0 && last != blank - W) {
+            next_cells.push_back(blank - W);
+        }
+        int next = next_cells[random() % next_cells.size()];
+        tiles[blank] = tiles[next];
+        tiles[next] = 0;
+        last = blank;
+        blank = next;
+    }
+
+    std::ostringstream input;
+    for (int i = 0; i < cells; ++i) {
+        input << (i ? " " : "") << tiles[i];
+    }
+    return input.str();
+}
+
+/**
+ * Times every implementation of the kernel on the same states, both the
+ * way an expansion scores its children, a few at a time, and the way a
+ * whole frontier would be scored, and writes a line for each. Every
+ * implementation must give the same estimates as the scalar one.
+ * @param {int} states_count The number of states to score.
+ * @param {int} rounds How many times each state is scored.
+ * @param {mt19937} random The random number generator.
+ * @return {boolean} true if every implementation agreed.
+ */
+template <int W, int H>
+bool RunBenchmark(int states_count, int rounds, std::mt19937 &random) {
+    typedef HeuristicKernel<W, H> Kernel;
+    const typename Kernel::Implementation implementations[3] = {
+        Kernel::SCALAR, Kernel::SSE4, Kernel::AVX2};
+
+    // Every board is scored against the first goal state of the solver.
+    Board<W, H> board(MakeRandomWalk<W, H>(200, random));
+    board.CreateBoard();
+    const Kernel &kernel = board.GetProblem().goals[0]->kernel;
+    std::vector<typename Board<W, H>::State> states;
+    for (int i = 0; i < states_count; ++i) {
+        int moves = 20 + random() % 200;
+        Board<W, H> walk(MakeRandomWalk<W, H>(moves, random));
+        walk.CreateBoard();
+        states.push_back(walk.GetState());
+    }
+
+    bool agreed = true;
+    for (int linear_conflict = 0; linear_conflict < 2; ++linear_conflict) {
+        std::vector<int> expected(states_count);
+        kernel.ScoreWith(Kernel::SCALAR, &states[0], states_count,
+                         linear_conflict, &expected[0]);
+        for (int i = 0; i < 3; ++i) {
+            if (!Kernel::IsAvailable(implementations[i])) {
+                std::cout << W * H - 1 << "-puzzle "
+                          << (linear_conflict ? "linear-conflict" :
+                              "manhattan")
+                          << " " << Kernel::GetName(implementations[i])
+                          << ": not available" << std::endl;
+                continue;
+            }
+            // The children of an expansion come 2 to 4 at a time.
+            for (int batch = 4; batch <= FRONTIER_BATCH;
+                 batch = (batch == 4) ? FRONTIER_BATCH : batch + 1) {
+                std::vector<int> estimates(states_count);
+                std::chrono::steady_clock::time_point start =
+                    std::chrono::steady_clock::now();
+                for (int round = 0; round < rounds; ++round) {
+                    for (int first = 0; first < states_count;
+                         first += batch) {
+                        int count = std::min(batch, states_count - first);
+                        kernel.ScoreWith(implementations[i], &states[first],
+                                         count, linear_conflict,
+                                         &estimates[first]);
+                    }
+                }
+                double elapsed_ns = std::chrono::duration<double,
+                    std::nano>(std::chrono::steady_clock::now() -
+                               start).count();
+                bool same = estimates == expected;
+                agreed = agreed && same;
+                std::cout << W * H - 1 << "-puzzle "
+                          << (linear_conflict ? "linear-conflict" :
+                              "manhattan")
+                          << " " << Kernel::GetName(implementations[i])
+                          << " batch " << batch << ": " << std::fixed
+                          << std::setprecision(2)
+                          << elapsed_ns / (1.0 * rounds * states_count)
+                          << " ns/state"
+                          << (same ? "" : " MISMATCH") << std::endl;
+            }
+        }
+    }
+    return agreed;
+}
+
+///////////////////
+// Start of main //
+///////////////////
+
+int main(int argc, char* argv[]) {
+    int states_count = 1 << 16;
+    int rounds = DEFAULT_ROUNDS;
+    unsigned int seed = 1;
+    for (int i = 1; i < argc; ++i) {
+        bool has_value = i + 1 < argc;
+        if (std::strcmp(argv[i], "--states") == 0 && has_value &&
+            std::atoi(argv[i + 1]) > 0) {
+            states_count = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--rounds") == 0 && has_value &&
+                   std::atoi(argv[i + 1]) > 0) {
+            rounds = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--seed") == 0 && has_value) {
+            seed = static_cast<unsigned int>(std::atol(argv[++i]));
+        } else {
+            std::cerr << "Unknown option: " << argv[i] << std::endl;
+            std::cerr << "Usage: " << argv[0]
+                      << " [--states N] [--rounds N] [--seed N]"
+                      << std::endl;
+            return 1;
+        }
+    }
+
+    std::mt19937 random(seed);
+    bool agreed = RunBenchmark<3, 3>(states_count, rounds, random);
+    agreed = RunBenchmark<4, 4>(states_count, rounds, random) && agreed;
+    if (!agreed) {
+        std::cerr << "The implementations gave different estimates"
+                  << std::endl;
+        return 1;
+    }
+    return 0;
+}
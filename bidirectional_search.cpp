@@ -0,0 +1,322 @@
+//////////////////////////////////////////////////////////
+// Assignment 1 : Lucas Silva                           //
+// The implementation file for the bidirectional search //
+//////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+#include <cassert>
+
+#include "headers/bidirectional_search.h"
+#include "headers/move_tables.h"
+
+namespace {
+
+/**
+ * Adds to or takes from the count kept for a value.
+ * @param {vector<long>} counts The counts, indexed by value.
+ * @param {int} value The value.
+ * @param {int} change The amount to add.
+ */
+void AddToCount(std::vector<long> &counts, int value, int change) {
+    if (static_cast<size_t>(value) >= counts.size()) {
+        counts.resize(value + 1, 0);
+    }
+    counts[value] += change;
+}
+
+/**
+ * Gets the smallest value with a count above zero.
+ * @param {vector<long>} counts The counts, indexed by value.
+ * @return {int} the smallest value counted.
+ */
+int SmallestCounted(const std::vector<long> &counts) {
+    for (size_t i = 0; i < counts.size(); ++i) {
+        if (counts[i] > 0) {
+            return static_cast<int>(i);
+        }
+    }
+    return static_cast<int>(counts.size());
+}
+
+}  // namespace
+
+/**
+ * Searches for a shortest solution from the given board.
+ * @param {Board} board The initial board, must have been created.
+ * @return {boolean} true if a solution was found.
+ */
+template <int W, int H>
+bool BidirectionalSearch<W, H>::Solve(const Board<W, H> &board) {
+    assert(board.IsValid());
+    const int kCells = W * H;
+
+    this->path_.clear();
+    this->best_moves_ = -1;
+    for (int side = FORWARD_; side <= BACKWARD_; ++side) {
+        this->sides_[side].nodes.clear();
+        this->sides_[side].open = std::priority_queue<OpenEntry,
+            std::vector<OpenEntry>, OpenEntryCompare>();
+        this->sides_[side].open_ranks.clear();
+        this->sides_[side].open_moves.clear();
+        this->sides_[side].expanded = 0;
+    }
+    this->stats_ = SearchStats();
+    if (board.IsAtGoalState()) {
+        return true;
+    }
+
+    // The backward search heads for the tiles of the initial board.
+    State start = board.GetState();
+    for (int cell = 0; cell < kCells; ++cell) {
+        this->start_cell_[start.Get(cell)] = cell;
+    }
+
+    // The forward search heads for every goal state of the board, so the
+    // backward search starts from all of them at once.
+    this->Reach_(FORWARD_, start, 0, board.GetEstimatedMovesRemaining(), -1);
+    for (int i = 0; i < board.GetGoalCount(); ++i) {
+        const State &goal = board.GetGoal(i).state;
+        this->Reach_(BACKWARD_, goal, 0, this->DistanceToStart_(goal), -1);
+    }
+
+    // Every new board is found by moving this one.
+    Board<W, H> scratch(board);
+    while (this->SkipStaleEntries_(FORWARD_) &&
+           this->SkipStaleEntries_(BACKWARD_)) {
+        const Side &forward = this->sides_[FORWARD_];
+        const Side &backward = this->sides_[BACKWARD_];
+        int forward_priority = forward.open.top().priority;
+        int backward_priority = backward.open.top().priority;
+
+        // Any solution not found yet is at least as long as each of these.
+        if (this->best_moves_ != -1) {
+            int lower_bound = std::min(forward_priority, backward_priority);
+            lower_bound = std::max(lower_bound,
+                                   SmallestCounted(forward.open_ranks));
+            lower_bound = std::max(lower_bound,
+                                   SmallestCounted(backward.open_ranks));
+            lower_bound = std::max(lower_bound,
+                                   SmallestCounted(forward.open_moves) +
+                                   SmallestCounted(backward.open_moves) + 1);
+            if (this->best_moves_ <= lower_bound) {
+                break;
+            }
+        }
+
+        if (forward_priority <= backward_priority) {
+            this->Expand_(FORWARD_, scratch);
+        } else {
+            this->Expand_(BACKWARD_, scratch);
+        }
+        this->stats_.UpdatePeakOpen(forward.open.size() +
+                                    backward.open.size());
+    }
+
+    // Either both open lists still have boards that can't beat the
+    // solution, or one of the searches reached every state it could.
+    if (this->best_moves_ == -1) {
+        return false;
+    }
+
+    // The moves of the forward search, from the initial board to the
+    // meeting state, then those of the backward search taken back.
+    std::vector<int> forward_moves;
+    this->FollowMovesBack_(FORWARD_, scratch, forward_moves);
+    for (size_t i = forward_moves.size(); i > 0; --i) {
+        this->path_.push_back(forward_moves[i - 1]);
+    }
+    std::vector<int> backward_moves;
+    this->FollowMovesBack_(BACKWARD_, scratch, backward_moves);
+    for (size_t i = 0; i < backward_moves.size(); ++i) {
+        this->path_.push_back(InverseDirection(backward_moves[i]));
+    }
+    assert(static_cast<int>(this->path_.size()) == this->best_moves_);
+    return true;
+}
+
+//////////////////////////////
+// Private helper functions //
+//////////////////////////////
+
+/**
+ * Gets the sum of manhattan distances from a state to the initial board.
+ * @param {State} state The state.
+ * @return {int} the estimated number of moves back to the initial board.
+ * @private
+ */
+template <int W, int H>
+int BidirectionalSearch<W, H>::DistanceToStart_(const State &state) const {
+    int distance = 0;
+    for (int cell = 0; cell < W * H; ++cell) {
+        int tile = state.Get(cell);
+        if (tile == 0) {
+            continue;
+        }
+        int start_cell = this->start_cell_[tile];
+        distance += std::abs(cell / W - start_cell / W) +
+            std::abs(cell % W - start_cell % W);
+    }
+    return distance;
+}
+
+/**
+ * Puts a state reached by one of the searches on its open list, unless
+ * it was already reached in as few moves, and checks if the other
+ * search has reached it too.
+ * @param {int} side FORWARD_ or BACKWARD_.
+ * @param {State} state The state.
+ * @param {int} moves_made The number of moves made to reach it.
+ * @param {int} estimated_moves_remaining The heuristic of the state.
+ * @param {int} direction The direction of the move that reached it.
+ * @private
+ */
+template <int W, int H>
+void BidirectionalSearch<W, H>::Reach_(int side, const State &state,
+                                       int moves_made,
+                                       int estimated_moves_remaining,
+                                       int direction) {
+    Side &current = this->sides_[side];
+    typename std::unordered_map<State, Node, StateHash>::iterator it =
+        current.nodes.find(state);
+    if (it != current.nodes.end()) {
+        Node &node = it->second;
+        if (node.moves_made <= moves_made) {
+            this->stats_.CountDuplicate();
+            return;
+        }
+        // A shorter path to it, so it goes back on the open list.
+        if (node.open) {
+            AddToCount(current.open_ranks,
+                       node.moves_made + node.estimated_moves_remaining, -1);
+            AddToCount(current.open_moves, node.moves_made, -1);
+        }
+    }
+
+    Node &node = current.nodes[state];
+    node.moves_made = moves_made;
+    node.estimated_moves_remaining = estimated_moves_remaining;
+    node.direction = direction;
+    node.open = true;
+
+    OpenEntry entry;
+    entry.priority = std::max(moves_made + estimated_moves_remaining,
+                              2 * moves_made);
+    entry.moves_made = moves_made;
+    entry.state = state;
+    current.open.push(entry);
+    AddToCount(current.open_ranks, moves_made + estimated_moves_remaining, 1);
+    AddToCount(current.open_moves, moves_made, 1);
+
+    // If the other search got here too, the two halves make a solution.
+    const Side &other = this->sides_[1 - side];
+    typename std::unordered_map<State, Node, StateHash>::const_iterator
+        met = other.nodes.find(state);
+    if (met != other.nodes.end()) {
+        int moves = moves_made + met->second.moves_made;
+        if (this->best_moves_ == -1 || moves < this->best_moves_) {
+            this->best_moves_ = moves;
+            this->meeting_state_ = state;
+        }
+    }
+}
+
+/**
+ * Takes the best board off one of the open lists and reaches the
+ * boards one move away from it.
+ * @param {int} side FORWARD_ or BACKWARD_.
+ * @param {Board} scratch A board that is moved to find the new states.
+ * @private
+ */
+template <int W, int H>
+void BidirectionalSearch<W, H>::Expand_(int side, Board<W, H> &scratch) {
+    Side &current = this->sides_[side];
+    State state = current.open.top().state;
+    current.open.pop();
+
+    Node &open_node = current.nodes[state];
+    open_node.open = false;
+    Node node = open_node;
+    AddToCount(current.open_ranks,
+               node.moves_made + node.estimated_moves_remaining, -1);
+    AddToCount(current.open_moves, node.moves_made, -1);
+    ++current.expanded;
+    this->stats_.CountExpansion(
+        node.moves_made + node.estimated_moves_remaining, node.moves_made);
+
+    scratch.SetState(state, node.moves_made);
+    int inverse_of_last = InverseDirection(node.direction);
+    const int move_count = move_tables<W, H>.move_count[state.blank];
+    for (int i = 0; i < move_count; ++i) {
+        int direction = move_tables<W, H>.moves[state.blank][i];
+        // Going straight back is never shorter.
+        if (direction == inverse_of_last) {
+            this->stats_.CountParentPrune();
+            continue;
+        }
+        scratch.MoveInDirection(direction);
+        this->stats_.CountGeneration();
+        State next = scratch.GetState();
+        // The board's own heuristic only knows the way to the goal state.
+        int estimated_moves_remaining = (side == FORWARD_) ?
+            scratch.GetEstimatedMovesRemaining() :
+            this->DistanceToStart_(next);
+        scratch.UndoMove(direction);
+        this->Reach_(side, next, node.moves_made + 1,
+                     estimated_moves_remaining, direction);
+    }
+}
+
+/**
+ * Drops the entries at the top of an open list that were improved on
+ * after they were put there.
+ * @param {int} side FORWARD_ or BACKWARD_.
+ * @return {boolean} true if the open list isn't empty.
+ * @private
+ */
+template <int W, int H>
+bool BidirectionalSearch<W, H>::SkipStaleEntries_(int side) {
+    Side &current = this->sides_[side];
+    while (!current.open.empty()) {
+        const OpenEntry &entry = current.open.top();
+        const Node &node = current.nodes[entry.state];
+        if (node.open && node.moves_made == entry.moves_made) {
+            return true;
+        }
+        current.open.pop();
+    }
+    return false;
+}
+
+/**
+ * Follows the moves of one of the searches back from the meeting state
+ * to where that search began.
+ * @param {int} side FORWARD_ or BACKWARD_.
+ * @param {Board} scratch A board that is moved to follow the moves.
+ * @param {vector<int>} directions Filled with the directions of the
+ *   moves, from the meeting state back.
+ * @private
+ */
+template <int W, int H>
+void BidirectionalSearch<W, H>::FollowMovesBack_(
+    int side, Board<W, H> &scratch, std::vector<int> &directions) const {
+    const Side &current = this->sides_[side];
+    State state = this->meeting_state_;
+    // A state's previous state always has fewer moves than it, so this ends.
+    while (true) {
+        const Node &node = current.nodes.find(state)->second;
+        if (node.direction == -1) {
+            return;
+        }
+        directions.push_back(node.direction);
+        scratch.SetState(state, node.moves_made);
+        scratch.UndoMove(node.direction);
+        state = scratch.GetState();
+    }
+}
+
+// The board sizes the solver supports: the 8-, 15- and 24-puzzle.
+template class BidirectionalSearch<3, 3>;
+template class BidirectionalSearch<4, 4>;
+template class BidirectionalSearch<5, 5>;
@@ -4,7 +4,10 @@
 /////////////////////////////////////////////////
 
 #include <iostream>
+#include <sstream>
 #include <cmath>
+#include <cctype>
+#include <cstdlib>
 #include <string>
 #include <algorithm>
 #include <utility>
@@ -12,6 +15,8 @@
 #include <vector>
 
 #include "headers/board.h"
+#include "headers/move_tables.h"
+#include "headers/pattern_database.h"
 
 #define RIGHT 1           // Represents a move to the right
 #define LEFT 2            // Represents a move to the left
@@ -19,121 +24,194 @@
 #define DOWN 4            // Represents a move down
 #define TOP_LEFT 5        // Represents a goal state with empty space at top left
 #define BOTTOM_RIGHT 6    // Represents a goal state with empty space at bottom right
+#define EITHER_GOAL 7     // Represents both of the goal states above at once
+#define CUSTOM_GOAL 8     // Represents goal states given by the user
+
+namespace {
 
 /**
- * Copy constructor for the board class.
- * @param {Board} the board to be copied
+ * Checks if a token is made up only of digits.
+ * @param {string} token The token.
+ * @return {boolean} true if every character is a digit.
  */
-Board::Board(const Board& board) {
-    assert(board.IsValid());
-
-    try {
-        this->board_ = new int*[3];
-        for (int i = 0; i < 3; ++i)
-            this->board_[i] = new int[3];
+bool IsNumber(const std::string &token) {
+    for (size_t i = 0; i < token.length(); ++i) {
+        if (!std::isdigit(static_cast<unsigned char>(token[i]))) {
+            return false;
+        }
     }
-    catch(std::bad_alloc exc) {
-        std::cerr << "ERROR: Memory allocation failed" << std::endl;
-        exit(1);
+    return !token.empty();
+}
+
+}  // namespace
+
+/**
+ * Splits the user input into tile values.
+ * @param {string} input The user input.
+ * @param {vector<int>} tiles Filled with the tile values, row by row.
+ * @return {boolean} false if something other than a number was found.
+ */
+bool ParseTiles(const std::string &input, std::vector<int> &tiles) {
+    tiles.clear();
+    std::vector<std::string> tokens;
+    std::istringstream stream(input);
+    std::string token;
+    while (stream >> token) {
+        if (!IsNumber(token)) {
+            return false;
+        }
+        tokens.push_back(token);
     }
 
-    for (int x = 0; x < 3; ++x) {
-        for (int y = 0; y < 3; ++y) {
-            this->board_[x][y] = board.GetValueAt(x, y);
+    // Every board has at least 9 tiles, so fewer tokens than that means
+    // the digits were run together, like '123 456 780'. Read those one
+    // digit per tile.
+    if (tokens.size() < 9) {
+        for (size_t i = 0; i < tokens.size(); ++i) {
+            for (size_t j = 0; j < tokens[i].length(); ++j) {
+                tiles.push_back(tokens[i][j] - '0');
+            }
         }
+        return true;
     }
-    this->empty_space_position_ = board.empty_space_position_;
+
+    for (size_t i = 0; i < tokens.size(); ++i) {
+        tiles.push_back(std::atoi(tokens[i].c_str()));
+    }
+    return true;
+}
+
+/**
+ * Copy constructor for the board class.
+ * @param {Board} the board to be copied
+ */
+template <int W, int H>
+Board<W, H>::Board(const Board& board) :
+    created_problem_(NULL), owns_problem_(false), problem_(board.problem_) {
+    assert(board.IsValid());
+
+    // The whole board is a few words, so copying it is a plain assignment.
+    // The input and goal state are pointed to, not copied, and stay with
+    // the board that made them.
+    this->state_ = board.state_;
+    this->direction_moved_ = board.direction_moved_;
     this->moves_made_ = board.moves_made_;
-    this->input_string_ = board.input_string_;
     this->estimated_moves_remaining_ = board.estimated_moves_remaining_;
-    this->previous_state_ = NULL;
-    this->goal_state_type_ = board.goal_state_type_;
+    for (int goal = 0; goal < board.problem_->goal_count; ++goal) {
+        this->goal_estimates_[goal] = board.goal_estimates_[goal];
+        for (int line = 0; line < W + H; ++line) {
+            this->line_conflicts_[goal][line] =
+                board.line_conflicts_[goal][line];
+        }
+    }
+}
 
-    assert(this->board_);
+/**
+ * Assignment operator for the board class. Like the copy constructor, it
+ * points to the problem context of the other board without owning it.
+ * @param {Board} the board to be copied
+ * @return {Board} this board
+ */
+template <int W, int H>
+Board<W, H>& Board<W, H>::operator=(const Board& board) {
+    assert(board.IsValid());
+
+    this->problem_ = board.problem_;
+    this->state_ = board.state_;
+    this->direction_moved_ = board.direction_moved_;
+    this->moves_made_ = board.moves_made_;
+    this->estimated_moves_remaining_ = board.estimated_moves_remaining_;
+    for (int goal = 0; goal < board.problem_->goal_count; ++goal) {
+        this->goal_estimates_[goal] = board.goal_estimates_[goal];
+        for (int line = 0; line < W + H; ++line) {
+            this->line_conflicts_[goal][line] =
+                board.line_conflicts_[goal][line];
+        }
+    }
+    return *this;
 }
 
 
 /**
  * Returns the value of the tile at board[x][y].
- * Retuns -1 if board hasn't been initialized yet.
- * @param {int} x The x coordinate of the point. 
+ * The board must have been initialized, and the coordinates in range.
+ * @param {int} x The x coordinate of the point.
  * @param {int} y The y coordinate of the point.
  * @return {int} The value of the tile at those coordinates.
  */
-const int Board::GetValueAt(int x, int y) const {
-    if (!this->board_) {
-        std::cerr << "ERROR: Board has not been initialized yet.\n";
-        exit(1);
-    }
-    if (x > 2 || x < 0 || y > 2 || y < 0) {
-        std::cerr << "ERROR: Coordinates out of range. \n";
-        exit(1);
-    }
-    return this->board_[x][y];
+template <int W, int H>
+const int Board<W, H>::GetValueAt(int x, int y) const {
+    assert(this->IsValid());
+    assert(x >= 0 && x < H && y >= 0 && y < W);
+    return this->state_.Get(x * W + y);
 }
 
 /**
  * Checks if a board has been allocated and initialized.
  * @return {boolean} true if board is valid.
  */
-bool Board::IsValid() const {
-    if (!this) {
-        return false;
-    }
-    if (!this->board_) {
+template <int W, int H>
+bool Board<W, H>::IsValid() const {
+    if (this->state_.blank == -1) {
         return false;
     }
     return true;
 }
 
 /**
-  * Allocates memory and initializes the board. 
+  * Initializes the board from the user input.
   * Must be called after making a new board instance.
-  * @return {boolean} true if allocation successful, false otherwise.
+  * @return {boolean} true if the input was valid, false otherwise.
   */
-bool Board::CreateBoard() {
-    // Try to allocate board, if it fails then return false.
-    if (!this->AllocateBoard_()) {return false;}
+template <int W, int H>
+bool Board<W, H>::CreateBoard() {
+    // Check if the board has already been created.
+    if (this->IsValid()) {
+        std::cerr << "ERROR: Board has already been created" << std::endl;
+        return false;
+    }
     // Make sure input string is valid.
-    std::string input = this->TrimSpaceFromInputString_();
-    if (input.length() != 9) {
-        std::cerr << "ERROR: Invalid input. Need 9 tiles." << std::endl;
-        this->DestroyBoard_();
+    std::vector<int> tiles;
+    if (!ParseTiles(this->problem_->input, tiles)) {
+        std::cerr << "ERROR: Invalid input. Tiles must be numbers.";
+        std::cerr << std::endl;
+        return false;
+    }
+    if (tiles.size() != kCells) {
+        std::cerr << "ERROR: Invalid input. Need " << kCells << " tiles.";
+        std::cerr << std::endl;
         return false;
     }
+    // Fill in a scratch state, so the board stays invalid on bad input.
+    State state;
     // Array used to check for duplicate numbers. All entries
     // are initialized to zero, and as the numbers are read their
     // index in the array is made true.
-    bool check_for_duplicates_array[9];
-    for (int i = 0; i < 9; ++i) {
+    bool check_for_duplicates_array[kCells];
+    for (int i = 0; i < kCells; ++i) {
         check_for_duplicates_array[i] = false;
     }
 
     // Actually fill in the tile values.
-    for (int tile = 0; tile < input.length(); tile++) {
-        // Convert the char to int and set it to that position in board.
-        int tile_number = input[tile] - '0';
-        if (tile_number < 0 || tile_number > 8) {
-            std::cerr << "ERROR: Tiles are only valid in range 0-8 \n";
-            this->DestroyBoard_();
+    for (int tile = 0; tile < kCells; tile++) {
+        int tile_number = tiles[tile];
+        if (tile_number < 0 || tile_number > kCells - 1) {
+            std::cerr << "ERROR: Tiles are only valid in range 0-";
+            std::cerr << kCells - 1 << " \n";
             return false;
         }
         // Check for duplicate numbers.
         if (check_for_duplicates_array[tile_number]) {
             std::cerr << "ERROR: Tiles must be unique! \n";
-            this->DestroyBoard_();
             return false;
         }
         check_for_duplicates_array[tile_number] = true;
-        this->board_[tile/3][tile%3] = tile_number;
-        // If this is the empty space, store its current position on the board.
-        if (tile_number == 0) {
-            this->empty_space_position_ = std::make_pair(tile/3, tile%3);
-        }
+        // Setting the empty space also stores its position on the board.
+        state.Set(tile, tile_number);
     }
-    // Determine if goal state should be with blank space
-    // at the top left or at the bottom right, depending
-    // on whichever one has a lower heuristic value.
+    this->state_ = state;
+    // Determine which goal states can be reached, the search is done
+    // towards all of them at once.
     this->DetermineGoalState_();
 
     this->CalculateAndSetHeuristic_();
@@ -143,60 +221,63 @@ bool Board::CreateBoard() {
 /**
  * Prints the board,
  */
-void Board::PrintBoard() const {
-    // If the board hasn't been allocated, then can't print it.
-    if (!this->board_) {
+template <int W, int H>
+void Board<W, H>::PrintBoard() const {
+    // If the board hasn't been created, then can't print it.
+    if (!this->IsValid()) {
         std::cerr << "ERROR: Please make sure CreateBoard has been called.";
         std::cerr << std::endl;
         return;
     }
-    std::cout << "-----------" << std::endl;
-    for (int x = 0; x < 3; ++x) {
+    // Every tile is printed as wide as the largest one.
+    const int tile_width = (kCells - 1 < 10) ? 1 : 2;
+    const std::string border(2 + W * (tile_width + 2), '-');
+    std::cout << border << std::endl;
+    for (int x = 0; x < H; ++x) {
         std::cout << "|";
-        for (int y = 0; y < 3; ++y) {
+        for (int y = 0; y < W; ++y) {
             std::cout << " ";
-            if (this->board_[x][y] == 0) {
-                std::cout << " ";
+            int value = this->state_.Get(x * W + y);
+            if (value == 0) {
+                std::cout << std::string(tile_width, ' ');
             } else {
-                std::cout << this->board_[x][y];
+                if (tile_width == 2 && value < 10) {
+                    std::cout << " ";
+                }
+                std::cout << value;
             }
             std::cout << " ";
         }
         std::cout << "|\n";
     }
-    std::cout << "-----------" << std::endl;
+    std::cout << border << std::endl;
 }
 
 /**
- * Displays all the previous board states, in order.
+ * Displays every board of a solution, in order, by replaying its moves on a
+ * copy of this board. Only one board is alive at a time.
+ * @param {MoveSequence} moves The moves of the solution.
  */
-void Board::DisplayAllSteps() {
-    // Vector to hold all the board states
-    std::vector<Board*> all_boards;
-
-    // Add all the board states to the vector, in reverse order.
-    Board* board = this;
-    while (board) {
-        all_boards.push_back(board);
-        board = board->GetPreviousState();
-    }
-
-    // Quick check to make sure the size of the vector is correct.
-    assert(all_boards.size() == this->moves_made_ + 1);
-
-    int number_of_boards = all_boards.size() - 1;
-    for (int i = number_of_boards; i > -1; --i) {
-        assert(all_boards[i]->IsValid());
-
-        if (number_of_boards - i == 0) {
-            std::cout << "INITIAL BOARD" << std::endl;
-        } else if (i == 0) {
+template <int W, int H>
+void Board<W, H>::DisplaySolution(const MoveSequence &moves) const {
+    assert(this->IsValid());
+
+    Board board(*this);
+    std::cout << "INITIAL BOARD" << std::endl;
+    board.PrintBoard();
+    std::cout << std::endl;
+    for (size_t i = 0; i < moves.size(); ++i) {
+        bool moved = board.MoveInDirection(moves[i]);
+        assert(moved);
+        (void) moved;
+
+        if (i + 1 == moves.size()) {
             std::cout << "GOAL STATE" << std::endl;
         } else {
-            std::cout << "MOVE: " << all_boards[i]->GetMovesMade() << " - ";
+            std::cout << "MOVE: " << board.GetMovesMade() << " - ";
 
             // Print out the direction of the move
-            switch (all_boards[i]->direction_moved_) {
+            switch (board.direction_moved_) {
                 case RIGHT:
                     std::cout << "moved right" << std::endl;
                     break;
@@ -211,17 +292,38 @@ void Board::DisplayAllSteps() {
                     break;
             }
         }
-        all_boards[i]->PrintBoard();
+        board.PrintBoard();
         std::cout << std::endl;
     }
 }
 
+/**
+ * Checks that a solution is made of legal moves, and that they take this
+ * board to its goal state.
+ * @param {MoveSequence} moves The moves of the solution.
+ * @return {boolean} true if the moves solve the board.
+ */
+template <int W, int H>
+bool Board<W, H>::IsSolvedBy(const MoveSequence &moves) const {
+    if (!this->IsValid()) {
+        return false;
+    }
+    Board board(*this);
+    for (size_t i = 0; i < moves.size(); ++i) {
+        if (!board.MoveInDirection(moves[i])) {
+            return false;
+        }
+    }
+    return board.IsAtGoalState();
+}
+
 /**
  * Gets the value of the heuristic function.
  * @return {int} The sum of the manhattan distances of all the tiles.
  */
-int Board::GetHeuristicValue() {
-    if (!this->board_ || this->estimated_moves_remaining_ == -1) {
+template <int W, int H>
+int Board<W, H>::GetHeuristicValue() {
+    if (!this->IsValid() || this->estimated_moves_remaining_ == -1) {
         std::cerr << "No board. Please make sure CreateBoard has been called.";
         std::cerr << std::endl;
         return -1;
@@ -230,45 +332,176 @@ int Board::GetHeuristicValue() {
 }
 
 /**
- * Determines if the board is solvable, given the initial configuration.
+ * Determines if a goal state can be reached from the board.
  * @return {boolean} true if solvable, false otherwise.
  */
-bool Board::IsSolvable() {
-    // If the number of inversions needed to solve the 
-    // problem is even, then it is solvable. Otherwise it is 
-    // not. Explanation can be found here:
-    // http://ldc.usb.ve/~gpalma/ci2693sd08/puzzleFactible.txt
-    int number_of_inversions = 0;
-    std::string input = this->TrimSpaceFromInputString_();
-    for (unsigned int i = 1; i < input.length(); ++i) {
-        int current_number = input[i] - '0';
-        if (current_number == 0) {
-            continue;
+template <int W, int H>
+bool Board<W, H>::IsSolvable() const {
+    for (int goal = 0; goal < this->problem_->goal_count; ++goal) {
+        if (this->IsSolvableForGoal_(*this->problem_->goals[goal])) {
+            return true;
         }
-        for (int j = i - 1; j > -1; --j) {
-            int previous_number = input[j] - '0';
-            if (previous_number > current_number) {
-                ++number_of_inversions;
-            }
+    }
+    return false;
+}
+
+
+/**
+ * Takes back a move in the given direction, which must have been the last
+ * move made, by moving the empty space back the opposite way.
+ * @param {int} direction The direction of the move being taken back.
+ */
+template <int W, int H>
+void Board<W, H>::UndoMove(int direction) {
+    assert(this->moves_made_ > 0);
+
+    this->Slide_(InverseDirection(direction));
+    this->moves_made_ = this->moves_made_ - 1;
+    // The move before this one isn't remembered.
+    this->direction_moved_ = -1;
+}
+
+/**
+ * Makes the state of every board one move away from this one, and
+ * estimates the moves remaining from all of them at once.
+ * @param {State[]} children Filled with the states, at most 4.
+ * @param {int[]} directions Filled with the direction of each move.
+ * @param {int[]} estimates Filled with the heuristic of each state.
+ * @return {int} the number of boards one move away.
+ */
+template <int W, int H>
+int Board<W, H>::GetChildren(State children[4], int directions[4],
+                             int estimates[4]) {
+    assert(this->IsValid());
+
+    const int blank = this->state_.blank;
+    const int count = move_tables<W, H>.move_count[blank];
+    for (int i = 0; i < count; ++i) {
+        directions[i] = move_tables<W, H>.moves[blank][i];
+    }
+    this->GetChildrenInDirections(directions, count, children, estimates);
+    return count;
+}
+
+/**
+ * Makes the state of the boards one move away from this one in the given
+ * directions, and estimates the moves remaining from them.
+ * @param {int[]} directions The directions, each a possible move.
+ * @param {int} count The number of directions, at most 4.
+ * @param {State[]} children Filled with the states.
+ * @param {int[]} estimates Filled with the heuristic of each state.
+ */
+template <int W, int H>
+void Board<W, H>::GetChildrenInDirections(const int* directions, int count,
+                                          State children[4],
+                                          int estimates[4]) {
+    assert(this->IsValid() && count <= 4);
+
+    const int blank = this->state_.blank;
+    const ProblemContext<W, H> &problem = *this->problem_;
+    if (!pattern_database_ && !use_linear_conflict_ &&
+        problem.goal_count == 1) {
+        // Only the tile that slides into the empty space changes distance.
+        const GoalState<W, H> &goal = *problem.goals[0];
+        for (int i = 0; i < count; ++i) {
+            int next_cell = move_tables<W, H>.neighbour[blank][directions[i]];
+            int tile = this->state_.Get(next_cell);
+            children[i] = this->state_;
+            children[i].Swap(blank, next_cell);
+            children[i].blank = next_cell;
+            estimates[i] = this->estimated_moves_remaining_ +
+                goal.distance[tile][blank] - goal.distance[tile][next_cell];
         }
+        return;
     }
-    if (number_of_inversions%2 == 0) {
-        return true;
-    } else {
-        return false;
+
+    bool score_together = HeuristicKernel<W, H>::kVectorized &&
+        !pattern_database_;
+    // Taking back a move forgets the one before it.
+    int direction_moved = this->direction_moved_;
+    for (int i = 0; i < count; ++i) {
+        int direction = directions[i];
+        if (score_together) {
+            int next_cell = move_tables<W, H>.neighbour[blank][direction];
+            children[i] = this->state_;
+            children[i].Swap(blank, next_cell);
+            children[i].blank = next_cell;
+        } else {
+            this->Move_(direction);
+            children[i] = this->state_;
+            estimates[i] = this->estimated_moves_remaining_;
+            this->UndoMove(direction);
+        }
+    }
+    this->direction_moved_ = direction_moved;
+    if (score_together) {
+        // Each child is as far as its closest goal state.
+        problem.goals[0]->kernel.Score(children, count, use_linear_conflict_,
+                                       estimates);
+        for (int goal = 1; goal < problem.goal_count; ++goal) {
+            int goal_estimates[4];
+            problem.goals[goal]->kernel.Score(children, count,
+                                              use_linear_conflict_,
+                                              goal_estimates);
+            for (int i = 0; i < count; ++i) {
+                estimates[i] = std::min(estimates[i], goal_estimates[i]);
+            }
+        }
     }
 }
 
+/**
+ * Puts the board in another state of the same puzzle, towards the same
+ * goal state, and recalculates the heuristic.
+ * @param {State} state The state.
+ * @param {int} moves_made The number of moves made to reach it.
+ */
+template <int W, int H>
+void Board<W, H>::SetState(const State &state, int moves_made) {
+    assert(this->IsValid() && state.blank != -1);
+
+    this->state_ = state;
+    this->moves_made_ = moves_made;
+    this->direction_moved_ = -1;
+    this->CalculateAndSetHeuristic_();
+}
+
+/**
+ * Puts the board in another state of the same puzzle, with a heuristic
+ * that is already known. The linear conflicts of each line, which the
+ * moves keep up to date, are forgotten, and counted again when a move
+ * first needs them. So are the estimates towards each goal state, when
+ * there are more than one, as only the least of them is known.
+ * @param {State} state The state.
+ * @param {int} moves_made The number of moves made to reach it.
+ * @param {int} estimated_moves_remaining The heuristic of the state.
+ */
+template <int W, int H>
+void Board<W, H>::SetState(const State &state, int moves_made,
+                           int estimated_moves_remaining) {
+    assert(this->IsValid() && state.blank != -1);
+
+    this->state_ = state;
+    this->moves_made_ = moves_made;
+    this->direction_moved_ = -1;
+    this->estimated_moves_remaining_ = estimated_moves_remaining;
+    this->goal_estimates_[0] = (this->problem_->goal_count == 1) ?
+        estimated_moves_remaining : kUnknownEstimate;
+    // The lines are only counted once a move needs them.
+    for (int goal = 0; goal < this->problem_->goal_count; ++goal) {
+        for (int line = 0; line < W + H; ++line) {
+            this->line_conflicts_[goal][line] = kUnknownConflicts;
+        }
+    }
+}
 
 /**
  * Determine whether a move to the right is possible.
  * @return {boolean} true if possible.
  */
-bool Board::CanMoveRight() const {
-    if (this->GetEmptySpaceColumn() >= 2) {
-        return false;
-    }
-    return true;
+template <int W, int H>
+bool Board<W, H>::CanMoveRight() const {
+    return move_tables<W, H>.neighbour[this->state_.blank][RIGHT] != -1;
 }
 
 
@@ -276,7 +509,8 @@ bool Board::CanMoveRight() const {
  * Moves the empty space to the right.
  * @return {boolean} true if the move was successful, false otherwise.
  */
-bool Board::MoveRight() {
+template <int W, int H>
+bool Board<W, H>::MoveRight() {
     if (!this->CanMoveRight()) {
         return false;
     }
@@ -289,18 +523,17 @@ bool Board::MoveRight() {
  * Determine whether a move to the left is possible.
  * @return {boolean} true if possible.
  */
-bool Board::CanMoveLeft() const {
-    if (this->GetEmptySpaceColumn() <= 0) {
-        return false;
-    }
-    return true;
+template <int W, int H>
+bool Board<W, H>::CanMoveLeft() const {
+    return move_tables<W, H>.neighbour[this->state_.blank][LEFT] != -1;
 }
 
 /**
  * Moves the empty space to the left.
  * @return {boolean} true if the move was successful, false otherwise.
  */
-bool Board::MoveLeft() {
+template <int W, int H>
+bool Board<W, H>::MoveLeft() {
     if (!this->CanMoveLeft()) {
         return false;
     }
@@ -313,18 +546,17 @@ bool Board::MoveLeft() {
  * Determine whether a move down is possible.
  * @return {boolean} true if possible.
  */
-bool Board::CanMoveDown() const {
-    if (this->GetEmptySpaceRow() >= 2) {
-        return false;
-    }
-    return true;
+template <int W, int H>
+bool Board<W, H>::CanMoveDown() const {
+    return move_tables<W, H>.neighbour[this->state_.blank][DOWN] != -1;
 }
 
 /**
  * Moves the empty space down.
  * @return {boolean} true if the move was successful, false otherwise.
  */
-bool Board::MoveDown() {
+template <int W, int H>
+bool Board<W, H>::MoveDown() {
     if (!this->CanMoveDown()) {
         return false;
     }
@@ -337,18 +569,17 @@ bool Board::MoveDown() {
  * Determine whether a move up is possible.
  * @return {boolean} true if possible.
  */
-bool Board::CanMoveUp() const {
-    if (this->GetEmptySpaceRow() <= 0) {
-        return false;
-    }
-    return true;
+template <int W, int H>
+bool Board<W, H>::CanMoveUp() const {
+    return move_tables<W, H>.neighbour[this->state_.blank][UP] != -1;
 }
 
 /**
  * Moves the empty space up.
  * @return {boolean} true if the move was successful, false otherwise.
  */
-bool Board::MoveUp() {
+template <int W, int H>
+bool Board<W, H>::MoveUp() {
     if (!this->CanMoveUp()) {
         return false;
     }
@@ -357,224 +588,333 @@ bool Board::MoveUp() {
     return true;
 }
 
+/**
+ * Moves the empty space in the given direction, if possible, like the
+ * Move* methods.
+ * @param {int} direction The direction of the move.
+ * @return {boolean} true if the move was made.
+ */
+template <int W, int H>
+bool Board<W, H>::MoveInDirection(int direction) {
+    // Direction 0 is never a move, and anything else is out of range.
+    if (static_cast<unsigned int>(direction) > DOWN ||
+        move_tables<W, H>.neighbour[this->state_.blank][direction] == -1) {
+        return false;
+    }
+    this->Move_(direction);
+    this->direction_moved_ = direction;
+    return true;
+}
+
 //////////////////////////////
 // Private helper functions //
 //////////////////////////////
 
 /**
- * Deallocates dynamic memory used to store the board.
- * @private
- */
-void Board::DestroyBoard_() {
-    if (this->board_) {
-        for (int i = 0; i < 3; ++i) {
-            delete [] this->board_[i];
-            this->board_[i] = NULL;
-        }
-        delete [] this->board_;
-        this->board_ = NULL;
+  * Calculates the sum of the manhattan distances of every piece on the
+  * board from where it belongs in a goal state.
+  * @param {GoalState} goal The goal state.
+  * @private
+  * @return {int} The sum of the manhattan distances.
+  */
+template <int W, int H>
+int Board<W, H>::CalculateSumOfManhattanDistances_(
+    const GoalState<W, H> &goal) const {
+    // The empty space is zero distance away, so it needs no check.
+    int manhattanDistanceSum = 0;
+    for (int cell = 0; cell < kCells; ++cell) {
+        manhattanDistanceSum += goal.distance[this->state_.Get(cell)][cell];
     }
+    return manhattanDistanceSum;
 }
 
 /**
- * Allocate dynamic memory used to store the board.
+ * Determines if a goal state can be reached from the board, by comparing
+ * the parity of the number of inversions (plus the row of the empty space,
+ * on boards of even width) with the same parity for the goal state.
+ * @param {GoalState} goal The goal state.
+ * @return {boolean} true if the goal state can be reached.
  * @private
- * @return {boolean} true if allocation successful, false otherwise.
  */
-bool Board::AllocateBoard_() {
-    // Check if memory has already been allocated.
-    if (this->board_) {
-        std::cerr << "ERROR: Memory has already been allocated" << std::endl;
-        return false;
-    }
-    try {
-        this->board_ = new int*[3];
-        for (int i = 0; i < 3; ++i)
-            this->board_[i] = new int[3];
-        return true;
-    }
-    catch(std::bad_alloc exc) {
-        std::cerr << "ERROR: Memory allocation failed" << std::endl;
-        return false;
-    }
+template <int W, int H>
+bool Board<W, H>::IsSolvableForGoal_(const GoalState<W, H> &goal) const {
+    return GoalState<W, H>::GetParity(this->state_) == goal.parity;
 }
 
 /**
- * Returns the input string without any white space.
+ * Determines the goal states the board is solved towards, the ones the
+ * user gave or else the two standard ones, empty position at top left or
+ * at bottom right. Only those that can be reached are kept, so on boards
+ * of even width only one of the standard ones is. Rather than guessing
+ * which of them is closer, the search goes towards all of them at once.
  * @private
- * @return {string} string without whitespace
- */
-std::string Board::TrimSpaceFromInputString_() {
-    std::string str = this->input_string_;
-    for (size_t i = 0; i < str.length(); i++) {
-        if (str[i] == ' ' || str[i] == '\n' || str[i] == '\t') {
-            str.erase(i, 1);
-            i--;
+ */
+template <int W, int H>
+void Board<W, H>::DetermineGoalState_() {
+    const GoalState<W, H>* candidates[ProblemContext<W, H>::kMaxGoals];
+    int candidate_count = 0;
+    if (custom_goals_) {
+        const size_t kMaxGoals = ProblemContext<W, H>::kMaxGoals;
+        assert(custom_goals_->size() <= kMaxGoals);
+        (void) kMaxGoals;
+        for (size_t i = 0; i < custom_goals_->size(); ++i) {
+            candidates[candidate_count++] = &(*custom_goals_)[i];
+        }
+    } else {
+        candidates[candidate_count++] =
+            &GoalState<W, H>::GetStandard(TOP_LEFT);
+        candidates[candidate_count++] =
+            &GoalState<W, H>::GetStandard(BOTTOM_RIGHT);
+    }
+
+    ProblemContext<W, H> &problem = *this->created_problem_;
+    problem.goal_count = 0;
+    for (int i = 0; i < candidate_count; ++i) {
+        if (this->IsSolvableForGoal_(*candidates[i])) {
+            problem.goals[problem.goal_count++] = candidates[i];
+        }
+    }
+    // None can be reached, so keep them all, IsSolvable tells the caller.
+    if (problem.goal_count == 0) {
+        for (int i = 0; i < candidate_count; ++i) {
+            problem.goals[problem.goal_count++] = candidates[i];
         }
     }
-    return str;
-}
 
-/**
-  * Calculates the sum of all manhattan distances of every piece on the board.
-  * This is the heuristic function used for the A* algorithm.
-  * @private
-  * @return {int} The sum of the manhattan distances.
-  */
-int Board::CalculateSumOfManhattanDistances_() {
-    if (this->goal_state_type_ == TOP_LEFT) {
-        return this->CalculateSumOfManhattanDistancesTop_();
-    } else if (this->goal_state_type_ == BOTTOM_RIGHT) {
-        return this->CalculateSumOfManhattanDistancesBottom_();
+    if (problem.goal_count == 1) {
+        problem.goal_state_type = problem.goals[0]->type;
     } else {
-        std::cerr << "Invalid goal state type!" << std::endl;
-        exit(1);
+        problem.goal_state_type = custom_goals_ ? CUSTOM_GOAL : EITHER_GOAL;
     }
 }
 
 /**
- * Calculates sum of the manhattan distances of every piece, using
- * the empty square at the top right as the goal state.
- * @return {int} The sum of the manhattan distances.
+ * Recalculates the heuristic function, which estimates how many
+ *   moves remain to get to goal state.
+ *   Also sets estimated_moves_remaining_;
  * @private
+ * @return {int} The calculated heuristic value.
  */
-int Board::CalculateSumOfManhattanDistancesTop_() {
-    int manhattanDistanceSum = 0;
-    for (int x = 0; x < 3; ++x) {
-        for (int y = 0; y < 3; ++y) {
-            int value = this->board_[x][y];
-            if (value != 0) {
-                int targetX = (value) / 3;
-                int targetY = (value) % 3;
-                int dx = x - targetX;
-                int dy = y - targetY;
-                manhattanDistanceSum += std::abs(dx) + std::abs(dy);
+template <int W, int H>
+int Board<W, H>::CalculateAndSetHeuristic_() {
+    // The board is as far as its closest goal state.
+    int value = 0;
+    for (int goal = 0; goal < this->problem_->goal_count; ++goal) {
+        const GoalState<W, H> &goal_state = *this->problem_->goals[goal];
+        int estimate;
+        if (pattern_database_) {
+            estimate = pattern_database_->GetEstimate(this->state_,
+                                                      goal_state.type);
+        } else if (HeuristicKernel<W, H>::kVectorized) {
+            goal_state.kernel.Score(&this->state_, 1, use_linear_conflict_,
+                                    &estimate);
+            // The lines are only counted once a move needs them.
+            for (int line = 0; line < W + H; ++line) {
+                this->line_conflicts_[goal][line] = kUnknownConflicts;
             }
+        } else {
+            estimate = this->CalculateSumOfManhattanDistances_(goal_state);
+            if (use_linear_conflict_) {
+                estimate += 2 * this->CalculateLineConflicts_(goal);
+            }
+        }
+        this->goal_estimates_[goal] = static_cast<short>(estimate);
+        if (goal == 0 || estimate < value) {
+            value = estimate;
         }
     }
-    return manhattanDistanceSum;
+    this->estimated_moves_remaining_ = value;
+    return value;
 }
 
 /**
- * Calculates sum of the manhattan distances of every piece, using
- * the empty square at the bottom left as the goal state.
- * @return {int} The sum of the manhattan distances.
+ * Counts the linear conflicts in a row or column.
+ * @param {int} goal The index of the goal state.
+ * @param {int} line A row, or H plus a column.
+ * @return {int} the number of tiles that must leave the line.
  * @private
  */
-int Board::CalculateSumOfManhattanDistancesBottom_() {
-    int manhattanDistanceSum = 0;
-    for (int x = 0; x < 3; ++x) {
-        for (int y = 0; y < 3; ++y) {
-            int value = this->board_[x][y];
-            if (value != 0) {
-                int targetX = (value - 1) / 3;
-                int targetY = (value - 1) % 3;
-                int dx = x - targetX;
-                int dy = y - targetY;
-                manhattanDistanceSum += std::abs(dx) + std::abs(dy);
-            }
+template <int W, int H>
+int Board<W, H>::CountLineConflicts_(int goal, int line) const {
+    const int* goal_cell = this->problem_->goals[goal]->cell;
+    const bool is_row = line < H;
+    const int length = is_row ? W : H;
+
+    // Where each tile that belongs in this line goes along it, in the
+    // order the tiles are in now.
+    int targets[W > H ? W : H];
+    int count = 0;
+    for (int i = 0; i < length; ++i) {
+        int cell = is_row ? line * W + i : i * W + (line - H);
+        int tile = this->state_.Get(cell);
+        if (tile == 0) {
+            continue;
+        }
+        int target = goal_cell[tile];
+        if (is_row && target / W == line) {
+            targets[count++] = target % W;
+        } else if (!is_row && target % W == line - H) {
+            targets[count++] = target / W;
         }
     }
-    return manhattanDistanceSum;
-}
 
-/**
- * Determines what the goal state should be, empty position at 
- * top left or empty positin at bottom right, depending on 
- * whichever one yields the lowest manhattan distance.
- * @private
- */
-void Board::DetermineGoalState_() {
-    int bottom_goal_state_heuristic =
-        this->CalculateSumOfManhattanDistancesBottom_();
-    int top_goal_state_heuristic =
-        this->CalculateSumOfManhattanDistancesTop_();
-    if (bottom_goal_state_heuristic < top_goal_state_heuristic) {
-        this->goal_state_type_ = BOTTOM_RIGHT;
-    } else {
-        this->goal_state_type_ = TOP_LEFT;
+    // The tiles that may stay are the longest run already in order.
+    int longest[W > H ? W : H];
+    int longest_in_order = 0;
+    for (int i = 0; i < count; ++i) {
+        longest[i] = 1;
+        for (int j = 0; j < i; ++j) {
+            if (targets[j] < targets[i] && longest[j] + 1 > longest[i]) {
+                longest[i] = longest[j] + 1;
+            }
+        }
+        if (longest[i] > longest_in_order) {
+            longest_in_order = longest[i];
+        }
     }
+    return count - longest_in_order;
 }
 
 /**
- * Recalculates the heuristic function, which estimates how many
- *   moves remain to get to goal state.
- *   Also sets estimated_moves_remaining_;
+ * Counts the linear conflicts of every row and column into
+ * line_conflicts_.
+ * @param {int} goal The index of the goal state.
+ * @return {int} the number of tiles that must leave their line.
  * @private
- * @return {int} The calculated heuristic value.
  */
-int Board::CalculateAndSetHeuristic_() {
-    int value = this->CalculateSumOfManhattanDistances_();
-    this->estimated_moves_remaining_ = value;
-    return value;
+template <int W, int H>
+int Board<W, H>::CalculateLineConflicts_(int goal) {
+    int conflicts = 0;
+    for (int line = 0; line < W + H; ++line) {
+        this->line_conflicts_[goal][line] =
+            this->CountLineConflicts_(goal, line);
+        conflicts += this->line_conflicts_[goal][line];
+    }
+    return conflicts;
 }
 
 /**
- * Swaps two values given their positions in the table. Used by move function.
- * @param point_1 one of the points to move
- * @param point_2 the second point to move
+ * Swaps two values given their cells in the table. Used by move function.
+ * @param cell_1 one of the cells to swap
+ * @param cell_2 the second cell to swap
  */
-void Board::Swap_(std::pair<int, int> point_1, std::pair<int, int> point_2) {
-    assert(point_1.first < 3 && point_1.first >= 0);
-    assert(point_1.second < 3 && point_1.second >= 0);
-    assert(point_2.first < 3 && point_2.first >= 0);
-    assert(point_2.second < 3 && point_2.second >= 0);
-
-    int value_at_point_1 = this->GetValueAt(point_1.first, point_1.second);
-    int value_at_point_2 = this->GetValueAt(point_2.first, point_2.second);
-    this->board_[point_1.first][point_1.second] = value_at_point_2;
-    this->board_[point_2.first][point_2.second] = value_at_point_1;
+template <int W, int H>
+void Board<W, H>::Swap_(int cell_1, int cell_2) {
+    assert(cell_1 < kCells && cell_1 >= 0);
+    assert(cell_2 < kCells && cell_2 >= 0);
+
+    this->state_.Swap(cell_1, cell_2);
+    // Keep the cached position of the empty space in sync.
+    if (this->state_.blank == cell_1) {
+        this->state_.blank = cell_2;
+    } else if (this->state_.blank == cell_2) {
+        this->state_.blank = cell_1;
+    }
 }
 
 /**
- * Moves the empty space to the right.
- * @return {pair<boolean, Board>} first value indicates if move successful,
- *   second value is the newly created Board after the move.
+ * Moves the empty space in the given direction, counting it as a move.
+ * @param {int} direction The direction of the move.
  * @private
  */
-void Board::Move_(int direction) {
-    std::pair<int, int> current_position = this->GetEmptySpacePosition();
-    std::pair<int, int> next_position;
-    switch (direction) {
-        case RIGHT:
-            next_position = std::make_pair(current_position.first ,
-                current_position.second + 1);
-            break;
-        case LEFT:
-            next_position = std::make_pair(current_position.first ,
-                current_position.second - 1);
-            break;
-        case UP:
-            next_position = std::make_pair(current_position.first - 1 ,
-                current_position.second);
-            break;
-        case DOWN:
-            next_position = std::make_pair(current_position.first + 1 ,
-                current_position.second);
-            break;
-    }
-    this->Swap_(current_position, next_position);
+template <int W, int H>
+void Board<W, H>::Move_(int direction) {
+    this->Slide_(direction);
     this->moves_made_ = this->moves_made_ + 1;
-    this->empty_space_position_ = next_position;
-    this->CalculateAndSetHeuristic_();
 }
 
-//////////////////////////
-// Overloaded operators //
-//////////////////////////
-
-bool operator==(const Board& lhs, const Board& rhs) {
-    // Do an element-by-element comparision of the boards.
-    for (int x = 0; x < 3; ++x) {
-        for (int y = 0; y < 3; ++y) {
-            if (lhs.GetValueAt(x, y) != rhs.GetValueAt(x, y)) {
-                return false;
+/**
+ * Slides the tile next to the empty space into it, and updates the
+ * heuristic. Does not touch the number of moves made.
+ * @param {int} direction The direction the empty space moves in.
+ * @private
+ */
+template <int W, int H>
+void Board<W, H>::Slide_(int direction) {
+    int current_cell = this->state_.blank;
+    int next_cell = move_tables<W, H>.neighbour[current_cell][direction];
+    assert(next_cell != -1);
+    // The tile next to the empty space slides into it, so the heuristic
+    // towards each goal state only changes by that one tile's distance,
+    // or by the estimate of that one tile's group.
+    int tile = this->state_.Get(next_cell);
+    const ProblemContext<W, H> &problem = *this->problem_;
+    const int goal_count = problem.goal_count;
+    if (this->goal_estimates_[0] == kUnknownEstimate) {
+        this->CalculateAndSetHeuristic_();
+    }
+    if (pattern_database_) {
+        int group = PatternDatabase<W, H>::GetGroup(tile);
+        for (int goal = 0; goal < goal_count; ++goal) {
+            this->goal_estimates_[goal] -= pattern_database_->
+                GetGroupEstimate(this->state_, problem.goals[goal]->type,
+                                 group);
+        }
+        this->Swap_(current_cell, next_cell);
+        for (int goal = 0; goal < goal_count; ++goal) {
+            this->goal_estimates_[goal] += pattern_database_->
+                GetGroupEstimate(this->state_, problem.goals[goal]->type,
+                                 group);
+        }
+    } else if (!use_linear_conflict_) {
+        this->Swap_(current_cell, next_cell);
+        for (int goal = 0; goal < goal_count; ++goal) {
+            const signed char* distance = problem.goals[goal]->distance[tile];
+            this->goal_estimates_[goal] +=
+                distance[current_cell] - distance[next_cell];
+        }
+    } else {
+        // The tile keeps its place in the line it moves along, so only
+        // the two lines across it, the one it left and the one it
+        // joined, can change.
+        bool moved_along_row = current_cell / W == next_cell / W;
+        int lines[2] = {
+            moved_along_row ? H + next_cell % W : next_cell / W,
+            moved_along_row ? H + current_cell % W : current_cell / W};
+        for (int goal = 0; goal < goal_count; ++goal) {
+            for (int i = 0; i < 2; ++i) {
+                if (this->line_conflicts_[goal][lines[i]] ==
+                    kUnknownConflicts) {
+                    this->line_conflicts_[goal][lines[i]] =
+                        this->CountLineConflicts_(goal, lines[i]);
+                }
+            }
+        }
+        this->Swap_(current_cell, next_cell);
+        for (int goal = 0; goal < goal_count; ++goal) {
+            const signed char* distance = problem.goals[goal]->distance[tile];
+            this->goal_estimates_[goal] +=
+                distance[current_cell] - distance[next_cell];
+            for (int i = 0; i < 2; ++i) {
+                int conflicts = this->CountLineConflicts_(goal, lines[i]);
+                this->goal_estimates_[goal] +=
+                    2 * (conflicts - this->line_conflicts_[goal][lines[i]]);
+                this->line_conflicts_[goal][lines[i]] = conflicts;
             }
         }
     }
-    return true;
+    int value = this->goal_estimates_[0];
+    for (int goal = 1; goal < goal_count; ++goal) {
+        value = std::min(value, static_cast<int>(this->goal_estimates_[goal]));
+    }
+    this->estimated_moves_remaining_ = value;
+#ifdef CHECK_INCREMENTAL_HEURISTIC
+    // Debug mode, make sure the update matches a full recalculation.
+    int estimated_moves_remaining = this->estimated_moves_remaining_;
+    assert(estimated_moves_remaining == this->CalculateAndSetHeuristic_());
+#endif
 }
 
-bool operator<(const Board &lhs, const Board &rhs) {
-    return lhs.GetRank() > rhs.GetRank();
-}
+template <int W, int H>
+const PatternDatabase<W, H>* Board<W, H>::pattern_database_ = NULL;
+
+template <int W, int H>
+bool Board<W, H>::use_linear_conflict_ = false;
+
+template <int W, int H>
+const std::vector<GoalState<W, H> >* Board<W, H>::custom_goals_ = NULL;
+
+// The board sizes the solver supports: the 8-, 15- and 24-puzzle.
+template class Board<3, 3>;
+template class Board<4, 4>;
+template class Board<5, 5>;
@@ -0,0 +1,117 @@
+//////////////////////////////////////////////////
+// Assignment 1 : Lucas Silva                   //
+// The implementation file for the bucket queue //
+//////////////////////////////////////////////////
+
+#include <vector>
+#include <cassert>
+
+#include "headers/bucket_queue.h"
+
+/**
+ * Adds a board to the bucket for its rank.
+ * @param {OpenEntry} entry The board to be added.
+ */
+template <int W, int H>
+void BucketQueue<W, H>::push(const OpenEntry<W, H> &entry) {
+    int rank = entry.rank;
+    int moves = entry.moves_made;
+    assert(rank >= 0 && moves >= 0 && moves <= rank);
+
+    // Grow the buckets to fit the rank, which only happens a few times.
+    if (rank >= static_cast<int>(this->buckets_.size())) {
+        this->buckets_.resize(rank + 1);
+        this->counts_.resize(rank + 1, 0);
+    }
+    std::vector<std::vector<OpenEntry<W, H> > > &bucket =
+        this->buckets_[rank];
+    if (moves >= static_cast<int>(bucket.size())) {
+        bucket.resize(moves + 1);
+    }
+    bucket[moves].push_back(entry);
+    ++this->counts_[rank];
+    ++this->size_;
+
+    // The new board may come out before the current next one.
+    if (rank < this->min_rank_) {
+        this->min_rank_ = rank;
+        this->max_moves_ = -1;
+    } else if (rank == this->min_rank_ && moves > this->max_moves_) {
+        this->max_moves_ = -1;
+    }
+}
+
+/**
+ * Gets the board with the lowest rank, and the most moves made among those.
+ * @return {OpenEntry} the board.
+ */
+template <int W, int H>
+const OpenEntry<W, H>& BucketQueue<W, H>::top() {
+    assert(!this->empty());
+    this->Settle_();
+    return this->buckets_[this->min_rank_][this->max_moves_].back();
+}
+
+/**
+ * Removes the board returned by top.
+ */
+template <int W, int H>
+void BucketQueue<W, H>::pop() {
+    assert(!this->empty());
+    this->Settle_();
+    std::vector<OpenEntry<W, H> > &boards =
+        this->buckets_[this->min_rank_][this->max_moves_];
+    boards.pop_back();
+    --this->counts_[this->min_rank_];
+    --this->size_;
+    if (boards.empty()) {
+        this->max_moves_ = -1;
+    }
+}
+
+/**
+ * Removes every board, keeping the memory of the buckets.
+ */
+template <int W, int H>
+void BucketQueue<W, H>::clear() {
+    for (size_t rank = 0; rank < this->buckets_.size(); ++rank) {
+        for (size_t moves = 0; moves < this->buckets_[rank].size(); ++moves) {
+            this->buckets_[rank][moves].clear();
+        }
+        this->counts_[rank] = 0;
+    }
+    this->size_ = 0;
+    this->min_rank_ = 0;
+    this->max_moves_ = -1;
+}
+
+//////////////////////////////
+// Private helper functions //
+//////////////////////////////
+
+/**
+ * Moves min_rank_ and max_moves_ to the bucket of the next board out.
+ * Both only ever scan a handful of small integers.
+ * @private
+ */
+template <int W, int H>
+void BucketQueue<W, H>::Settle_() {
+    if (this->max_moves_ != -1) {
+        return;
+    }
+    while (this->counts_[this->min_rank_] == 0) {
+        ++this->min_rank_;
+    }
+    std::vector<std::vector<OpenEntry<W, H> > > &bucket =
+        this->buckets_[this->min_rank_];
+    int moves = static_cast<int>(bucket.size()) - 1;
+    while (bucket[moves].empty()) {
+        --moves;
+    }
+    this->max_moves_ = moves;
+}
+
+// The board sizes the solver supports: the 8-, 15- and 24-puzzle.
+template class BucketQueue<3, 3>;
+template class BucketQueue<4, 4>;
+template class BucketQueue<5, 5>;
@@ -0,0 +1,134 @@
+////////////////////////////////////////////////
+// Assignment 1 : Lucas Silva                 //
+// The implementation file for the closed set //
+////////////////////////////////////////////////
+
+#include <vector>
+#include <algorithm>
+#include <cassert>
+
+#include "headers/closed_set.h"
+
+/**
+ * Constructor for the ClosedSet class.
+ */
+template <int W, int H>
+ClosedSet<W, H>::ClosedSet() : size_(0), duplicates_pruned_(0),
+    stale_nodes_skipped_(0) {
+    Entry empty = {State(), 0};
+    this->entries_.assign(kInitialCapacity, empty);
+}
+
+/**
+ * Records that a state was reached with the given number of moves.
+ * @param {State} state The state that was reached.
+ * @param {int} moves_made The number of moves it took to reach it.
+ * @return {boolean} true if this is the best path to the state so far.
+ */
+template <int W, int H>
+bool ClosedSet<W, H>::Insert(const State &state, int moves_made) {
+    assert(!state.IsZero());
+
+    Entry* entry = this->Find_(state);
+    if (!entry->key.IsZero()) {
+        if (entry->moves_made <= moves_made) {
+            ++this->duplicates_pruned_;
+            return false;
+        }
+        // Found a shorter path to a state seen before, so reopen it.
+        entry->moves_made = moves_made;
+        return true;
+    }
+
+    entry->key = state;
+    entry->moves_made = moves_made;
+    ++this->size_;
+    // Keep the load factor under 3/4 so probe sequences stay short.
+    if (this->size_ * 4 > this->entries_.size() * 3) {
+        this->Grow_();
+    }
+    return true;
+}
+
+/**
+ * Checks if a node taken off the open list has been superseded.
+ * @param {State} state The state of the node.
+ * @param {int} moves_made The number of moves made to reach the node.
+ * @return {boolean} true if the node should be skipped.
+ */
+template <int W, int H>
+bool ClosedSet<W, H>::IsStale(const State &state, int moves_made) {
+    Entry* entry = this->Find_(state);
+    if (!entry->key.IsZero() && entry->moves_made < moves_made) {
+        ++this->stale_nodes_skipped_;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * Forgets every state, keeping the memory for the next search unless the
+ * last one used only a small part of it.
+ */
+template <int W, int H>
+void ClosedSet<W, H>::Clear() {
+    Entry empty = {State(), 0};
+    // The whole table is only wiped after a search that filled an eighth
+    // of it, so the wipe costs no more than that search did. A table grown
+    // by a long search goes back to its first size once a short search
+    // leaves it nearly empty, rather than every short search paying for it.
+    if (this->entries_.size() > kInitialCapacity &&
+        this->size_ * 8 < this->entries_.size()) {
+        std::vector<Entry>(kInitialCapacity, empty).swap(this->entries_);
+    } else {
+        std::fill(this->entries_.begin(), this->entries_.end(), empty);
+    }
+    this->size_ = 0;
+    this->duplicates_pruned_ = 0;
+    this->stale_nodes_skipped_ = 0;
+}
+
+//////////////////////////////
+// Private helper functions //
+//////////////////////////////
+
+/**
+ * Finds the slot holding a state, or the empty slot where it belongs,
+ * using linear probing.
+ * @param {State} state The state to look for.
+ * @return {Entry*} the slot.
+ * @private
+ */
+template <int W, int H>
+typename ClosedSet<W, H>::Entry* ClosedSet<W, H>::Find_(const State &state) {
+    size_t mask = this->entries_.size() - 1;
+    size_t slot = static_cast<size_t>(state.Hash()) & mask;
+    while (!this->entries_[slot].key.IsZero() &&
+           this->entries_[slot].key != state) {
+        slot = (slot + 1) & mask;
+    }
+    return &this->entries_[slot];
+}
+
+/**
+ * Doubles the number of slots and re-inserts every state.
+ * @private
+ */
+template <int W, int H>
+void ClosedSet<W, H>::Grow_() {
+    std::vector<Entry> old_entries;
+    old_entries.swap(this->entries_);
+    Entry empty = {State(), 0};
+    this->entries_.assign(old_entries.size() * 2, empty);
+
+    for (size_t i = 0; i < old_entries.size(); ++i) {
+        if (!old_entries[i].key.IsZero()) {
+            *this->Find_(old_entries[i].key) = old_entries[i];
+        }
+    }
+}
+
+// The board sizes the solver supports: the 8-, 15- and 24-puzzle.
+template class ClosedSet<3, 3>;
+template class ClosedSet<4, 4>;
+template class ClosedSet<5, 5>;
@@ -0,0 +1,330 @@
+////////////////////////////////////////////////////
+// Assignment 1 : Lucas Silva                     //
+// The implementation file for the distance table //
+////////////////////////////////////////////////////
+
+#include <stdint.h>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cassert>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "headers/distance_table.h"
+#include "headers/move_tables.h"
+
+#define TOP_LEFT 5        // Represents a goal state with empty space at top left
+#define BOTTOM_RIGHT 6    // Represents a goal state with empty space at bottom right
+#define EITHER_GOAL 7     // Represents both of the goal states above at once
+
+namespace {
+
+/* Written at the start of a saved table, to recognise it. */
+const char MAGIC[8] = {'8', 'P', 'U', 'Z', 'D', 'I', 'S', 'T'};
+
+/* Number of cells on the board, and tiles other than the empty space. */
+const int CELLS = 9;
+const int TILES = 8;
+
+/* Number of indices for each cell of the empty space, 8! / 2. */
+const uint32_t ORDERS_PER_BLANK = 20160;
+
+/* The weight of each digit of an 8 tile Lehmer code, (7 - i)!. */
+const uint32_t FACTORIALS[TILES] = {5040, 720, 120, 24, 6, 2, 1, 1};
+
+/**
+ * Gets the index of a board in the table of one goal.
+ * @param {int[]} cells The tile in each cell, 0 for the empty space.
+ * @param {int} index Set to the index of the board.
+ * @return {boolean} false if the tiles are in an odd order, which can
+ *   never reach the goal and shares its index with a board that can.
+ */
+bool IndexOf(const int cells[CELLS], uint32_t &index) {
+    int blank = -1;
+    int order[TILES];
+    int count = 0;
+    for (int i = 0; i < CELLS; ++i) {
+        if (cells[i] == 0) {
+            blank = i;
+        } else {
+            order[count++] = cells[i];
+        }
+    }
+    assert(blank != -1 && count == TILES);
+
+    // The digits of the Lehmer code add up to the number of inversions.
+    uint32_t code = 0;
+    int inversions = 0;
+    for (int i = 0; i < TILES; ++i) {
+        int digit = 0;
+        for (int j = i + 1; j < TILES; ++j) {
+            if (order[j] < order[i]) {
+                ++digit;
+            }
+        }
+        code += digit * FACTORIALS[i];
+        inversions += digit;
+    }
+    index = blank * ORDERS_PER_BLANK + code / 2;
+    return inversions % 2 == 0;
+}
+
+/**
+ * Gets the board with the given index, the inverse of IndexOf.
+ * @param {int} index The index of the board.
+ * @param {int[]} cells Filled with the tile in each cell.
+ */
+void BoardAt(uint32_t index, int cells[CELLS]) {
+    int blank = index / ORDERS_PER_BLANK;
+    uint32_t code = (index % ORDERS_PER_BLANK) * 2;
+
+    // Tiles not placed yet, smallest first.
+    int unused[TILES] = {1, 2, 3, 4, 5, 6, 7, 8};
+    int order[TILES];
+    int inversions = 0;
+    for (int i = 0; i < TILES; ++i) {
+        int digit = code / FACTORIALS[i];
+        code %= FACTORIALS[i];
+        order[i] = unused[digit];
+        for (int j = digit; j < TILES - i - 1; ++j) {
+            unused[j] = unused[j + 1];
+        }
+        inversions += digit;
+    }
+    // Of the two orders sharing the index, use the even one.
+    if (inversions % 2 != 0) {
+        int last = order[TILES - 1];
+        order[TILES - 1] = order[TILES - 2];
+        order[TILES - 2] = last;
+    }
+
+    int count = 0;
+    for (int i = 0; i < CELLS; ++i) {
+        cells[i] = (i == blank) ? 0 : order[count++];
+    }
+}
+
+/**
+ * Fills the distances of one goal with a breadth first search from it.
+ * @param {int[]} goal The tile in each cell of the goal state.
+ * @param {uint8_t*} distances The kStatesPerGoal distances to fill in.
+ */
+void SearchFromGoal(const int goal[CELLS], uint8_t* distances) {
+    std::memset(distances, DistanceTable::kUnreached,
+                DistanceTable::kStatesPerGoal);
+
+    std::vector<uint32_t> queue;
+    queue.reserve(DistanceTable::kStatesPerGoal);
+    uint32_t index;
+    IndexOf(goal, index);
+    distances[index] = 0;
+    queue.push_back(index);
+
+    int cells[CELLS];
+    for (size_t head = 0; head < queue.size(); ++head) {
+        BoardAt(queue[head], cells);
+        uint8_t distance = distances[queue[head]];
+        int blank = 0;
+        while (cells[blank] != 0) {
+            ++blank;
+        }
+        int row = blank / 3;
+        int column = blank % 3;
+        int neighbours[4] = {
+            column < 2 ? blank + 1 : -1, column > 0 ? blank - 1 : -1,
+            row > 0 ? blank - 3 : -1, row < 2 ? blank + 3 : -1};
+        for (int i = 0; i < 4; ++i) {
+            if (neighbours[i] == -1) {
+                continue;
+            }
+            cells[blank] = cells[neighbours[i]];
+            cells[neighbours[i]] = 0;
+            IndexOf(cells, index);
+            if (distances[index] == DistanceTable::kUnreached) {
+                distances[index] = distance + 1;
+                queue.push_back(index);
+            }
+            cells[neighbours[i]] = cells[blank];
+            cells[blank] = 0;
+        }
+    }
+}
+
+}  // namespace
+
+/**
+ * Destructor for the DistanceTable class.
+ */
+DistanceTable::~DistanceTable() {
+    this->Unload_();
+}
+
+/**
+ * Maps a table saved by Save into memory.
+ * @param {string} path The file to be mapped.
+ * @return {boolean} true if the file held a valid table.
+ */
+bool DistanceTable::Load(const std::string &path) {
+    this->Unload_();
+
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd == -1) {
+        return false;
+    }
+    size_t expected_size = sizeof(MAGIC) + 2 * kStatesPerGoal;
+    struct stat info;
+    if (fstat(fd, &info) == -1 ||
+        static_cast<size_t>(info.st_size) != expected_size) {
+        close(fd);
+        return false;
+    }
+    void* mapping = mmap(NULL, expected_size, PROT_READ, MAP_SHARED, fd, 0);
+    // The mapping stays valid once the file is closed.
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        return false;
+    }
+    if (std::memcmp(mapping, MAGIC, sizeof(MAGIC)) != 0) {
+        munmap(mapping, expected_size);
+        return false;
+    }
+
+    this->mapping_ = mapping;
+    this->mapping_size_ = expected_size;
+    this->distances_ = static_cast<const uint8_t*>(mapping) + sizeof(MAGIC);
+    return true;
+}
+
+/**
+ * Builds the table in memory, with a breadth first search from each
+ * goal state.
+ */
+void DistanceTable::Build() {
+    this->Unload_();
+
+    const int top_left_goal[CELLS] = {0, 1, 2, 3, 4, 5, 6, 7, 8};
+    const int bottom_right_goal[CELLS] = {1, 2, 3, 4, 5, 6, 7, 8, 0};
+    this->built_.resize(2 * kStatesPerGoal);
+    SearchFromGoal(top_left_goal, &this->built_[0]);
+    SearchFromGoal(bottom_right_goal, &this->built_[kStatesPerGoal]);
+    this->distances_ = &this->built_[0];
+}
+
+/**
+ * Saves the table to a file, so it can be mapped by Load.
+ * @param {string} path The file to be written.
+ * @return {boolean} true if the whole table was written.
+ */
+bool DistanceTable::Save(const std::string &path) const {
+    assert(this->IsReady());
+
+    std::ofstream file(path.c_str(), std::ios::out | std::ios::binary);
+    file.write(MAGIC, sizeof(MAGIC));
+    file.write(reinterpret_cast<const char*>(this->distances_),
+               2 * kStatesPerGoal);
+    file.close();
+    return !file.fail();
+}
+
+/**
+ * Gets the exact number of moves from a board to its closest goal
+ * state. Only the two standard goal states are in the table.
+ * @param {Board} board The board, must have been created.
+ * @return {int} the number of moves, or -1 if it cannot be solved or
+ *   its goal states aren't in the table.
+ */
+int DistanceTable::GetDistance(const Board<3, 3> &board) const {
+    assert(this->IsReady());
+
+    int cells[CELLS];
+    for (int i = 0; i < CELLS; ++i) {
+        cells[i] = board.GetState().Get(i);
+    }
+    uint32_t index;
+    if (!IndexOf(cells, index)) {
+        return -1;
+    }
+    uint8_t distance;
+    switch (board.GetGoalStateType()) {
+        case TOP_LEFT:
+            distance = this->distances_[index];
+            break;
+        case BOTTOM_RIGHT:
+            distance = this->distances_[index + kStatesPerGoal];
+            break;
+        case EITHER_GOAL:
+            // kUnreached is larger than any distance, so the closest goal
+            // state wins.
+            distance = std::min(this->distances_[index],
+                                this->distances_[index + kStatesPerGoal]);
+            break;
+        default:
+            // Only the two standard goal states are in the table.
+            return -1;
+    }
+    return (distance == kUnreached) ? -1 : distance;
+}
+
+/**
+ * Finds a shortest solution by always taking a move that is one closer
+ * to the goal.
+ * @param {Board} board The board, must have been created.
+ * @param {MoveSequence} path Filled with the moves.
+ * @return {boolean} true if the board can be solved.
+ */
+bool DistanceTable::FindPath(const Board<3, 3> &board,
+                             MoveSequence &path) const {
+    path.clear();
+    int distance = this->GetDistance(board);
+    if (distance == -1) {
+        return false;
+    }
+
+    Board<3, 3> walker(board);
+    while (distance > 0) {
+        bool moved_closer = false;
+        const int blank = walker.GetState().blank;
+        for (int i = 0; i < move_tables<3, 3>.move_count[blank] &&
+             !moved_closer; ++i) {
+            int direction = move_tables<3, 3>.moves[blank][i];
+            walker.MoveInDirection(direction);
+            if (this->GetDistance(walker) == distance - 1) {
+                path.push_back(direction);
+                moved_closer = true;
+            } else {
+                walker.UndoMove(direction);
+            }
+        }
+        // Some neighbour is always one closer, unless the table is corrupt.
+        if (!moved_closer) {
+            path.clear();
+            return false;
+        }
+        --distance;
+    }
+    return true;
+}
+
+//////////////////////////////
+// Private helper functions //
+//////////////////////////////
+
+/**
+ * Unmaps the file and forgets the table.
+ * @private
+ */
+void DistanceTable::Unload_() {
+    if (this->mapping_) {
+        munmap(this->mapping_, this->mapping_size_);
+        this->mapping_ = NULL;
+        this->mapping_size_ = 0;
+    }
+    this->built_.clear();
+    this->distances_ = NULL;
+}
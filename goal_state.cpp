@@ -0,0 +1,109 @@
+////////////////////////////////////////////////
+// Assignment 1 : Lucas Silva                 //
+// The implementation file for the goal state //
+////////////////////////////////////////////////
+
+#include <cstddef>
+#include <vector>
+
+#include "headers/goal_state.h"
+#include "headers/move_tables.h"
+
+#define TOP_LEFT 5        // Represents a goal state with empty space at top left
+#define BOTTOM_RIGHT 6    // Represents a goal state with empty space at bottom right
+
+/**
+ * Fills in the goal state and its tables from its tiles.
+ * @param {vector<int>} tiles The tile in each cell, row by row.
+ * @param {int} type TOP_LEFT, BOTTOM_RIGHT or CUSTOM_GOAL.
+ * @return {boolean} false if the tiles aren't a permutation.
+ */
+template <int W, int H>
+bool GoalState<W, H>::Create(const std::vector<int> &tiles, int type) {
+    if (tiles.size() != static_cast<size_t>(W * H)) {
+        return false;
+    }
+    bool seen[W * H] = {};
+    State state;
+    for (int i = 0; i < W * H; ++i) {
+        if (tiles[i] < 0 || tiles[i] >= W * H || seen[tiles[i]]) {
+            return false;
+        }
+        seen[tiles[i]] = true;
+        state.Set(i, tiles[i]);
+        this->cell[tiles[i]] = i;
+    }
+
+    this->type = type;
+    this->state = state;
+    for (int tile = 0; tile < W * H; ++tile) {
+        int target = this->cell[tile];
+        for (int cell = 0; cell < W * H; ++cell) {
+            // The empty space doesn't count.
+            this->distance[tile][cell] = (tile == 0) ? 0 :
+                static_cast<signed char>(
+                    AbsoluteValue(cell / W - target / W) +
+                    AbsoluteValue(cell % W - target % W));
+        }
+    }
+    this->parity = GetParity(state);
+    this->kernel.SetGoal(this->cell);
+    return true;
+}
+
+/**
+ * Gets one of the two standard goal states, made the first time it is
+ * asked for.
+ * @param {int} type TOP_LEFT or BOTTOM_RIGHT.
+ * @return {GoalState} the goal state.
+ */
+template <int W, int H>
+const GoalState<W, H>& GoalState<W, H>::GetStandard(int type) {
+    struct StandardGoals {
+        GoalState goals[2];
+
+        StandardGoals() {
+            for (int goal = 0; goal < 2; ++goal) {
+                std::vector<int> tiles(W * H);
+                for (int tile = 0; tile < W * H; ++tile) {
+                    tiles[move_tables<W, H>.goal_cell[goal][tile]] = tile;
+                }
+                this->goals[goal].Create(tiles,
+                                         goal == 0 ? TOP_LEFT : BOTTOM_RIGHT);
+            }
+        }
+    };
+    static const StandardGoals standard;
+    return standard.goals[type == TOP_LEFT ? 0 : 1];
+}
+
+/**
+ * Gets the parity of a state, which no move changes.
+ * @param {State} state The state.
+ * @return {int} 0 or 1.
+ */
+template <int W, int H>
+int GoalState<W, H>::GetParity(const State &state) {
+    int number_of_inversions = 0;
+    for (int i = 1; i < W * H; ++i) {
+        int current_number = state.Get(i);
+        if (current_number == 0) {
+            continue;
+        }
+        for (int j = i - 1; j > -1; --j) {
+            if (state.Get(j) > current_number) {
+                ++number_of_inversions;
+            }
+        }
+    }
+    int parity = number_of_inversions;
+    if (W % 2 == 0) {
+        parity += state.blank / W;
+    }
+    return parity % 2;
+}
+
+// The board sizes the solver supports: the 8-, 15- and 24-puzzle.
+template struct GoalState<3, 3>;
+template struct GoalState<4, 4>;
+template struct GoalState<5, 5>;
@@ -0,0 +1,329 @@
+/////////////////////////////////////////////////
+// Assignment 1 : Lucas Silva                  //
+// The implementation file for the HDA* search //
+/////////////////////////////////////////////////
+
+#include <climits>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <cassert>
+
+#include "headers/hda_star.h"
+#include "headers/move_tables.h"
+
+/*
+ * Constructor for the HdaStarSearch class.
+ * @param {int} threads The number of threads to search on.
+ */
+template <int W, int H>
+HdaStarSearch<W, H>::HdaStarSearch(int threads) :
+    threads_(threads < 1 ? 1 : threads), active_(0), best_moves_(INT_MAX),
+    goal_thread_(-1), goal_node_(0) {}
+
+/*
+ * Destructor for the HdaStarSearch class.
+ */
+template <int W, int H>
+HdaStarSearch<W, H>::~HdaStarSearch() {
+    this->Clear_();
+}
+
+/**
+ * Searches for a shortest solution from the given board.
+ * @param {Board} board The initial board, must have been created.
+ * @return {boolean} true if a solution was found.
+ */
+template <int W, int H>
+bool HdaStarSearch<W, H>::Solve(const Board<W, H> &board) {
+    assert(board.IsValid());
+
+    this->Clear_();
+    this->path_.clear();
+    this->stats_.clear();
+    this->best_moves_.store(INT_MAX);
+    this->goal_thread_ = -1;
+    this->goal_node_ = 0;
+    if (board.IsAtGoalState()) {
+        return true;
+    }
+
+    for (int i = 0; i < this->threads_; ++i) {
+        Worker* worker = new Worker();
+        worker->inbox.store(NULL);
+        worker->outgoing.resize(this->threads_);
+        worker->stats = ThreadStats();
+        this->workers_.push_back(worker);
+    }
+
+    // The initial board goes straight to its owner, before any thread runs.
+    Message root;
+    root.state = board.GetState();
+    root.moves_made = board.GetMovesMade();
+    root.estimated_moves_remaining = board.GetEstimatedMovesRemaining();
+    root.parent_thread = -1;
+    root.parent = 0;
+    root.direction = -1;
+    this->Receive_(this->Owner_(root.state), root);
+
+    // Every thread starts out working.
+    this->active_.store(this->threads_);
+    std::vector<std::thread> threads;
+    for (int i = 1; i < this->threads_; ++i) {
+        threads.push_back(std::thread(&HdaStarSearch::Work_, this, i,
+                                      std::cref(board)));
+    }
+    // This thread is the first worker.
+    this->Work_(0, board);
+    for (size_t i = 0; i < threads.size(); ++i) {
+        threads[i].join();
+    }
+
+    for (int i = 0; i < this->threads_; ++i) {
+        this->stats_.push_back(this->workers_[i]->stats);
+    }
+    if (this->goal_thread_ == -1) {
+        return false;
+    }
+
+    // Follow the previous states back to the initial board. A node's
+    // previous state always has fewer moves than it, so this ends.
+    int thread = this->goal_thread_;
+    uint32_t node = this->goal_node_;
+    while (thread != -1) {
+        const Node &step = this->workers_[thread]->nodes[node];
+        if (step.parent_thread != -1) {
+            this->path_.push_back(step.direction);
+        }
+        thread = step.parent_thread;
+        node = step.parent;
+    }
+    this->path_.Reverse();
+    return true;
+}
+
+/**
+ * Gets what every thread did together during the last search.
+ * @return {SearchStats} the statistics of the last search.
+ */
+template <int W, int H>
+SearchStats HdaStarSearch<W, H>::GetStats() const {
+    SearchStats stats;
+    for (size_t i = 0; i < this->stats_.size(); ++i) {
+        stats.Add(this->stats_[i].search);
+    }
+    return stats;
+}
+
+//////////////////////////////
+// Private helper functions //
+//////////////////////////////
+
+/**
+ * Runs one thread of the search until it is over.
+ * @param {int} thread The index of the thread.
+ * @param {Board} board The initial board.
+ * @private
+ */
+template <int W, int H>
+void HdaStarSearch<W, H>::Work_(int thread, const Board<W, H> &board) {
+    Worker* worker = this->workers_[thread];
+    // Every board this thread expands is set up on this one.
+    Board<W, H> scratch(board);
+    bool working = true;
+
+    while (true) {
+        Batch* batches = worker->inbox.exchange(NULL,
+                                                std::memory_order_acquire);
+        if (batches && !working) {
+            // Count this thread as working again before the messages stop
+            // being counted, so the count can't touch zero in between.
+            this->active_.fetch_add(1);
+            working = true;
+        }
+        while (batches) {
+            Batch* batch = batches;
+            batches = batch->next;
+            for (size_t i = 0; i < batch->messages.size(); ++i) {
+                this->Receive_(thread, batch->messages[i]);
+            }
+            worker->stats.received += batch->messages.size();
+            this->active_.fetch_sub(batch->messages.size());
+            delete batch;
+        }
+
+        for (int expanded = 0; expanded < kExpansionsPerRound &&
+             !worker->open.empty(); ++expanded) {
+            OpenEntry entry = worker->open.top();
+            worker->open.pop();
+            // Copy the node, since receiving boards can move it.
+            Node node = worker->nodes[entry.node];
+            if (node.moves_made != entry.moves_made) {
+                // A shorter path to it was found after it was put here.
+                continue;
+            }
+            if (entry.rank >= this->best_moves_.load(
+                    std::memory_order_relaxed)) {
+                // Nothing left here can beat the best goal found so far.
+                worker->open = std::priority_queue<OpenEntry,
+                    std::vector<OpenEntry>, OpenEntryCompare>();
+                break;
+            }
+
+            worker->stats.search.CountExpansion(entry.rank, node.moves_made);
+            scratch.SetState(node.state, node.moves_made);
+            int inverse_of_last = InverseDirection(node.direction);
+            const int blank = node.state.blank;
+            const int move_count = move_tables<W, H>.move_count[blank];
+            for (int i = 0; i < move_count; ++i) {
+                int direction = move_tables<W, H>.moves[blank][i];
+                // Going straight back is never shorter.
+                if (direction == inverse_of_last) {
+                    worker->stats.search.CountParentPrune();
+                    continue;
+                }
+                scratch.MoveInDirection(direction);
+                Message message;
+                message.state = scratch.GetState();
+                message.moves_made = scratch.GetMovesMade();
+                message.estimated_moves_remaining =
+                    scratch.GetEstimatedMovesRemaining();
+                message.parent_thread = thread;
+                message.parent = entry.node;
+                message.direction = direction;
+                scratch.UndoMove(direction);
+
+                worker->stats.search.CountGeneration();
+                int owner = this->Owner_(message.state);
+                if (owner == thread) {
+                    this->Receive_(thread, message);
+                } else {
+                    worker->outgoing[owner].push_back(message);
+                    ++worker->stats.sent;
+                }
+            }
+        }
+        this->Flush_(thread);
+        worker->stats.search.UpdatePeakOpen(worker->open.size());
+
+        if (worker->open.empty() &&
+            worker->inbox.load(std::memory_order_relaxed) == NULL) {
+            if (working) {
+                this->active_.fetch_sub(1);
+                working = false;
+            }
+            // No thread is working and no message is on its way.
+            if (this->active_.load() == 0) {
+                return;
+            }
+        }
+        // Let threads sharing a core take their turn, since the boards
+        // they hold may be better than what is left here.
+        std::this_thread::yield();
+    }
+}
+
+/**
+ * Adds a new board to the thread that owns it, unless its state was
+ * already reached in as few moves or it can't beat the best goal.
+ * @param {int} thread The index of the owning thread.
+ * @param {Message} message The new board.
+ * @private
+ */
+template <int W, int H>
+void HdaStarSearch<W, H>::Receive_(int thread, const Message &message) {
+    Worker* worker = this->workers_[thread];
+    if (message.moves_made + message.estimated_moves_remaining >=
+        this->best_moves_.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    uint32_t index;
+    typename std::unordered_map<State, uint32_t, StateHash>::iterator it =
+        worker->index.find(message.state);
+    if (it == worker->index.end()) {
+        index = static_cast<uint32_t>(worker->nodes.size());
+        worker->nodes.push_back(Node());
+        worker->index.insert(std::make_pair(message.state, index));
+    } else if (worker->nodes[it->second].moves_made <= message.moves_made) {
+        ++worker->stats.duplicates;
+        worker->stats.search.CountDuplicate();
+        return;
+    } else {
+        index = it->second;
+    }
+
+    Node &node = worker->nodes[index];
+    node.state = message.state;
+    node.moves_made = message.moves_made;
+    node.parent_thread = message.parent_thread;
+    node.parent = message.parent;
+    node.direction = message.direction;
+
+    // Goal states are never expanded, only remembered if they are best.
+    if (message.estimated_moves_remaining == 0) {
+        std::lock_guard<std::mutex> lock(this->goal_mutex_);
+        if (message.moves_made < this->best_moves_.load()) {
+            this->best_moves_.store(message.moves_made);
+            this->goal_thread_ = thread;
+            this->goal_node_ = index;
+        }
+        return;
+    }
+
+    OpenEntry entry;
+    entry.rank = message.moves_made + message.estimated_moves_remaining;
+    entry.moves_made = message.moves_made;
+    entry.node = index;
+    worker->open.push(entry);
+}
+
+/**
+ * Sends every waiting message of a thread to the threads they are for.
+ * @param {int} thread The index of the sending thread.
+ * @private
+ */
+template <int W, int H>
+void HdaStarSearch<W, H>::Flush_(int thread) {
+    Worker* worker = this->workers_[thread];
+    for (int i = 0; i < this->threads_; ++i) {
+        if (worker->outgoing[i].empty()) {
+            continue;
+        }
+        Batch* batch = new Batch();
+        batch->messages.swap(worker->outgoing[i]);
+        // The messages count as work until they are received.
+        this->active_.fetch_add(batch->messages.size());
+
+        std::atomic<Batch*> &inbox = this->workers_[i]->inbox;
+        batch->next = inbox.load(std::memory_order_relaxed);
+        while (!inbox.compare_exchange_weak(batch->next, batch,
+                                            std::memory_order_release,
+                                            std::memory_order_relaxed)) {
+        }
+    }
+}
+
+/**
+ * Frees the nodes, open lists and batches of the last search.
+ * @private
+ */
+template <int W, int H>
+void HdaStarSearch<W, H>::Clear_() {
+    for (size_t i = 0; i < this->workers_.size(); ++i) {
+        Batch* batch = this->workers_[i]->inbox.load();
+        while (batch) {
+            Batch* next = batch->next;
+            delete batch;
+            batch = next;
+        }
+        delete this->workers_[i];
+        this->workers_[i] = NULL;
+    }
+    this->workers_.clear();
+}
+
+// The board sizes the solver supports: the 8-, 15- and 24-puzzle.
+template class HdaStarSearch<3, 3>;
+template class HdaStarSearch<4, 4>;
+template class HdaStarSearch<5, 5>;
@@ -0,0 +1,205 @@
+///////////////////////////////////////
+// Assignment 1 : Lucas Silva        //
+// The header file for the A* search //
+///////////////////////////////////////
+
+#ifndef _a_star_search_h
+#define _a_star_search_h
+
+#include <stdint.h>
+#include <cstddef>
+#include <queue>
+#include <vector>
+
+#include "board.h"
+#include "move_sequence.h"
+#include "bucket_queue.h"
+#include "closed_set.h"
+#include "packed_state.h"
+#include "search_stats.h"
+
+/**
+ * The class used to order the entries in the priority queue, by the rank
+ * of their boards only.
+ */
+template <int W, int H>
+class QueueCompareClass {
+ public:
+    bool operator() (const OpenEntry<W, H> &rhs,
+                     const OpenEntry<W, H> &lhs) const {
+        return rhs.rank > lhs.rank;
+    }
+};
+
+/*
+    The A* search. Boards are taken off an open list in order of rank
+    (moves made + estimated moves remaining), and the boards one move away
+    are put on it, until a goal state comes up. The open list is a binary
+    heap, or a BucketQueue if asked for.
+    A board on the open list is only its state, rank and moves made. Every
+    board reached also gets a node: a single 32-bit word in a vector, with
+    the index of the node it was reached from and the 2-bit direction of
+    the move. That is all that is left of a board once it is expanded, and
+    all that is needed to follow the moves back from the goal state. A
+    single scratch board makes the boards one move away from each one
+    expanded, and scores them all at once. The closed set, the open lists
+    and the nodes are kept between searches, so a single AStarSearch can
+    solve many boards in a row without allocating again.
+    With partial expansion (EPEA*), expanding a board only makes the
+    boards one move away with the rank it was taken off the open list
+    with, and puts the board itself back with the next rank of the others,
+    if any are left. Most boards one move away have
+    a higher rank than the solution and are never made, so the open list
+    and the nodes stay far smaller. The moves tried from a board come from
+    a table for its empty cell and the move that reached it, and with the
+    manhattan distance to a single goal state a child's rank is a lookup.
+    Below is a list of its private data members and their default value:
+        - {boolean}          use_buckets_       -> the given value
+        - {boolean}          partial_expansion_ -> the given value
+        - {ClosedSet}        closed_            -> initialized to empty
+        - {EntryHeap}        heap_              -> initialized to empty
+        - {BucketQueue}      buckets_           -> initialized to empty
+        - {vector<uint32_t>} nodes_             -> initialized to empty
+        - {MoveSequence}     path_              -> initialized to empty
+        - {SearchStats}      stats_             -> initialized to zero
+*/
+template <int W, int H>
+class AStarSearch {
+ public:
+    /* The packed representation of the tiles. */
+    typedef PackedState<W * H> State;
+
+    /*
+     * Constructor for the AStarSearch class.
+     * @param {boolean} use_buckets true to use a BucketQueue as the open
+     *   list instead of a binary heap.
+     * @param {boolean} partial_expansion true to only make the boards one
+     *   move away with the same rank as the board expanded.
+     */
+    explicit AStarSearch(bool use_buckets, bool partial_expansion = false) :
+        use_buckets_(use_buckets), partial_expansion_(partial_expansion) {}
+
+    /**
+     * Searches for a shortest solution from the given board.
+     * @param {Board} board The initial board, must have been created.
+     * @return {boolean} true if a solution was found.
+     */
+    bool Solve(Board<W, H> &board);
+
+    /**
+     * Gets the moves of the solution found by Solve.
+     * @return {MoveSequence} the moves, from the initial board on.
+     */
+    const MoveSequence& GetPath() const {return this->path_;}
+
+    /**
+     * Gets the number of distinct states the last search reached.
+     * @return {size_t} the number of states reached.
+     */
+    size_t GetStatesReached() const {return this->closed_.GetSize();}
+
+    /**
+     * Gets the number of boards the last search dropped because their
+     * state had already been reached with as few moves.
+     * @return {long} the number of duplicates pruned.
+     */
+    long GetDuplicatesPruned() const {
+        return this->closed_.GetDuplicatesPruned();}
+
+    /**
+     * Gets the number of boards the last search skipped because a shorter
+     * path to their state was found after they were put on the open list.
+     * @return {long} the number of stale nodes skipped.
+     */
+    long GetStaleNodesSkipped() const {
+        return this->closed_.GetStaleNodesSkipped();}
+
+    /**
+     * Gets what the last search did: the boards expanded and generated,
+     * the peak size of the open list, and more with SEARCH_STATS defined.
+     * @return {SearchStats} the statistics of the last search.
+     */
+    const SearchStats& GetStats() const {return this->stats_;}
+
+ private:
+    /* The default open list, a binary heap ordered by rank, which can be
+       emptied without giving back its memory. */
+    class EntryHeap : public std::priority_queue<OpenEntry<W, H>,
+        std::vector<OpenEntry<W, H> >, QueueCompareClass<W, H> > {
+     public:
+        void clear() {this->c.clear();}
+    };
+
+    /* true to use a BucketQueue as the open list. */
+    bool use_buckets_;
+    /* true to expand boards partially. */
+    bool partial_expansion_;
+    /* The states reached so far, with the fewest moves to each. */
+    ClosedSet<W, H> closed_;
+    /* The open lists, only one of which is used. */
+    EntryHeap heap_;
+    BucketQueue<W, H> buckets_;
+    /* How every board the search has reached was reached, the initial
+       board first: the index of its parent node times 4, plus the
+       direction of the move from it minus 1. */
+    std::vector<uint32_t> nodes_;
+    /* The moves of the last solution. */
+    MoveSequence path_;
+    /* What the last search did. */
+    SearchStats stats_;
+
+    /* Stands for no node at all. */
+    static const uint32_t kNoNode = 0xffffffff;
+    /* The most nodes a search can have, so a parent fits in 30 bits. */
+    static const uint32_t kMaxNodes = 1u << 30;
+
+    /**
+     * Runs the search with the given kind of open list.
+     * @param {Board} board The initial board.
+     * @param {Queue} pq The open list, emptied first.
+     * @return {uint32_t} the node at the goal state, or kNoNode if there
+     *   is none.
+     * @private
+     */
+    template <class Queue>
+    uint32_t Search_(const Board<W, H> &board, Queue &pq);
+
+    /**
+     * Moves a board in every possible direction, and puts the new boards
+     * that haven't been reached in as few moves on the open list.
+     * @param {OpenEntry} entry The board to be expanded.
+     * @param {Board} scratch A board that is moved to make the new boards.
+     * @param {Queue} queue The open list.
+     * @return {uint32_t} a new node at the goal state, or kNoNode.
+     * @private
+     */
+    template <class Queue>
+    uint32_t Expand_(const OpenEntry<W, H> &entry, Board<W, H> &scratch,
+                     Queue &queue);
+
+    /**
+     * Moves a board in the directions whose new board has the same rank
+     * as the board, and puts those that haven't been reached in as few
+     * moves on the open list. Then puts the board back on the open list
+     * with the least rank of the other new boards, if there are any.
+     * @param {OpenEntry} entry The board to be expanded.
+     * @param {Board} scratch A board that is moved to make the new boards.
+     * @param {Queue} queue The open list.
+     * @return {uint32_t} a new node at the goal state, or kNoNode.
+     * @private
+     */
+    template <class Queue>
+    uint32_t ExpandPartially_(const OpenEntry<W, H> &entry,
+                              Board<W, H> &scratch, Queue &queue);
+
+    /**
+     * Adds a node for a board reached from a parent node.
+     * @param {uint32_t} parent The node it was reached from.
+     * @param {int} direction The direction of the move from the parent.
+     * @return {uint32_t} the index of the new node.
+     * @private
+     */
+    uint32_t AddNode_(uint32_t parent, int direction);
+};
+
+#endif
@@ -0,0 +1,294 @@
+////////////////////////////////////////////
+// Assignment 1 : Lucas Silva             //
+// The header file for the anytime search //
+////////////////////////////////////////////
+
+#ifndef _anytime_search_h
+#define _anytime_search_h
+
+#include <stdint.h>
+#include <chrono>
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+#include "board.h"
+#include "move_sequence.h"
+#include "packed_state.h"
+#include "search_stats.h"
+
+/*
+    How a weighted or anytime search is run, and how much it may spend.
+    A limit of zero means there is none.
+    Below is a list of its data members and their default value:
+        - {double}  weight        -> initialized to 1
+        - {double}  weight_step   -> initialized to 0.5
+        - {boolean} improve       -> initialized to false
+        - {long}    time_limit_ms -> initialized to zero
+        - {long}    node_limit    -> initialized to zero
+*/
+struct AnytimeSettings {
+    /* The weight on the estimated moves remaining, at least 1. */
+    double weight;
+    /* How much the weight is lowered by after each solution. */
+    double weight_step;
+    /* true to keep improving the solution while the budget lasts. */
+    bool improve;
+    /* The most wall time the search may take, in milliseconds. */
+    long time_limit_ms;
+    /* The most boards the search may expand. */
+    long node_limit;
+
+    AnytimeSettings() : weight(1), weight_step(0.5), improve(false),
+        time_limit_ms(0), node_limit(0) {}
+};
+
+/*
+    Weighted A*, and an anytime search built on it (ARA*). Boards are taken
+    off the open list in order of moves made + weight * estimated moves
+    remaining, like the rank of the A* search with the heuristic trusted
+    more, which finds a solution much sooner, at most weight times longer
+    than the shortest one.
+    To keep improving the solution, the weight is then lowered and the
+    search goes on from where it stopped, instead of starting over. A board
+    is expanded at most once for each weight; one reached in fewer moves
+    after it was expanded waits until the next weight. The search stops
+    when the weight gets to 1, which proves the solution is the shortest,
+    or when it runs out of time or boards to expand. Every solution comes
+    with a bound that its length is proven to be within, as a multiple of
+    the shortest one.
+    Below is a list of its private data members and their default value:
+        - {AnytimeSettings}     settings_      -> initialized to the given value
+        - {unordered_map}       nodes_         -> initialized to empty
+        - {vector<OpenEntry>}   open_          -> initialized to empty
+        - {vector<State>}       inconsistent_  -> initialized to empty
+        - {int}                 weight_        -> initialized to zero
+        - {int}                 round_         -> initialized to zero
+        - {int}                 best_moves_    -> initialized to -1
+        - {State}               goal_state_    -> initialized to empty
+        - {double}              bound_         -> initialized to zero
+        - {boolean}             out_of_budget_ -> initialized to false
+        - {time_point}          start_time_    -> initialized to zero
+        - {MoveSequence}        path_          -> initialized to empty
+        - {vector<Improvement>} improvements_  -> initialized to empty
+        - {SearchStats}         stats_         -> initialized to zero
+*/
+template <int W, int H>
+class AnytimeSearch {
+ public:
+    /* The packed representation of the tiles. */
+    typedef PackedState<W * H> State;
+
+    /* A solution found along the way. */
+    struct Improvement {
+        /* The number of moves of the solution. */
+        int moves;
+        /* Its length is at most this times the shortest one's. */
+        double bound;
+        /* The wall time from the start of the search, in milliseconds. */
+        double wall_ms;
+        /* The number of boards expanded before it was found. */
+        long expanded;
+    };
+
+    /*
+     * Constructor for the AnytimeSearch class.
+     * @param {AnytimeSettings} settings The weight and the budget.
+     */
+    explicit AnytimeSearch(const AnytimeSettings &settings) :
+        settings_(settings), weight_(0), round_(0), best_moves_(-1),
+        bound_(0), out_of_budget_(false) {}
+
+    /**
+     * Changes the weight and the budget of the searches to come.
+     * @param {AnytimeSettings} settings The weight and the budget.
+     */
+    void SetSettings(const AnytimeSettings &settings) {
+        this->settings_ = settings;}
+
+    /**
+     * Searches for a solution from the given board, improving it for as
+     * long as the settings allow.
+     * @param {Board} board The initial board, must have been created.
+     * @return {boolean} true if a solution was found within the budget.
+     */
+    bool Solve(const Board<W, H> &board);
+
+    /**
+     * Gets the moves of the best solution found by Solve.
+     * @return {MoveSequence} the moves, from the initial board on.
+     */
+    const MoveSequence& GetPath() const {return this->path_;}
+
+    /**
+     * Gets how far the best solution may be from the shortest one.
+     * @return {double} its length is at most this times the shortest one's,
+     *   1 if it is proven to be the shortest.
+     */
+    double GetBound() const {return this->bound_;}
+
+    /**
+     * Gets every solution the last search found, each one shorter or with
+     * a tighter bound than the one before.
+     * @return {vector<Improvement>} the solutions, in the order found.
+     */
+    const std::vector<Improvement>& GetImprovements() const {
+        return this->improvements_;}
+
+    /**
+     * Checks if the last search stopped because the budget ran out.
+     * @return {boolean} true if it ran out of time or boards to expand.
+     */
+    bool IsOutOfBudget() const {return this->out_of_budget_;}
+
+    /**
+     * Gets what the last search did, over every weight.
+     * @return {SearchStats} the statistics of the last search.
+     */
+    const SearchStats& GetStats() const {return this->stats_;}
+
+ private:
+    /* The weight is kept in hundredths, so priorities are integers. */
+    static const int kWeightScale = 100;
+
+    /* A state the search reached. */
+    struct Node {
+        /* The fewest moves it was reached in so far. */
+        uint16_t moves_made;
+        /* The estimated number of moves to the goal state. */
+        uint16_t estimated_moves_remaining;
+        /* The direction of the move that reached it, -1 for the first. */
+        int8_t direction;
+        /* true while it is on the open list. */
+        bool open;
+        /* true while it waits for the next weight to be expanded again. */
+        bool inconsistent;
+        /* The last round it was expanded in, 0 if it never was. */
+        int round;
+    };
+
+    /* An open list entry, for a node that may since have been improved. */
+    struct OpenEntry {
+        int priority;
+        int moves_made;
+        State state;
+    };
+
+    /* Orders the open list by priority, then by most moves made. */
+    struct OpenEntryCompare {
+        bool operator()(const OpenEntry &lhs, const OpenEntry &rhs) const {
+            if (lhs.priority != rhs.priority) {
+                return lhs.priority > rhs.priority;
+            }
+            return lhs.moves_made < rhs.moves_made;
+        }
+    };
+
+    /* Hashes states for the node table. */
+    struct StateHash {
+        size_t operator()(const State &state) const {
+            return static_cast<size_t>(state.Hash());
+        }
+    };
+
+    /* How the search is run. */
+    AnytimeSettings settings_;
+    /* Every state reached. */
+    std::unordered_map<State, Node, StateHash> nodes_;
+    /* The open list, a binary heap kept with std::push_heap. */
+    std::vector<OpenEntry> open_;
+    /* The states reached in fewer moves after they were expanded. */
+    std::vector<State> inconsistent_;
+    /* The weight of the current round, in hundredths. */
+    int weight_;
+    /* The current round, one for each weight. */
+    int round_;
+    /* The moves made to the goal state, -1 if it wasn't reached. */
+    int best_moves_;
+    /* The goal state, once it was reached. */
+    State goal_state_;
+    /* The bound of the best solution, 0 if there is none. */
+    double bound_;
+    /* true once the budget ran out. */
+    bool out_of_budget_;
+    /* When the search started. */
+    std::chrono::steady_clock::time_point start_time_;
+    /* The moves of the best solution. */
+    MoveSequence path_;
+    /* Every solution found, in order. */
+    std::vector<Improvement> improvements_;
+    /* What the search did. */
+    SearchStats stats_;
+
+    /**
+     * Gets the priority of a board on the open list with the current
+     * weight.
+     * @param {int} moves_made The number of moves made to reach it.
+     * @param {int} estimated_moves_remaining The heuristic of the board.
+     * @return {int} the weighted rank, in hundredths.
+     * @private
+     */
+    int Priority_(int moves_made, int estimated_moves_remaining) const {
+        return moves_made * kWeightScale +
+            this->weight_ * estimated_moves_remaining;}
+
+    /**
+     * Expands boards in order of priority until nothing left on the open
+     * list could lead to a solution better than the weight allows, or the
+     * budget runs out.
+     * @param {Board} scratch A board that is moved to find the new states.
+     * @return {boolean} false if the budget ran out.
+     * @private
+     */
+    bool ImproveSolution_(Board<W, H> &scratch);
+
+    /**
+     * Puts a state on the open list, unless it was already reached in as
+     * few moves. If it was already expanded with the current weight, it
+     * waits for the next one instead.
+     * @param {State} state The state.
+     * @param {int} moves_made The number of moves made to reach it.
+     * @param {int} estimated_moves_remaining The heuristic of the state.
+     * @param {int} direction The direction of the move that reached it.
+     * @private
+     */
+    void Reach_(const State &state, int moves_made,
+                int estimated_moves_remaining, int direction);
+
+    /**
+     * Starts the next round: moves the states waiting for it onto the open
+     * list, and orders the open list again with the current weight.
+     * @private
+     */
+    void ReorderOpenList_();
+
+    /**
+     * Gets the bound of the best solution: its length over the lowest rank
+     * of any state on the open list or waiting for the next round, which
+     * no solution can be shorter than.
+     * @param {double} proven_weight The weight of the last round that ran
+     *   to the end, which also bounds the solution.
+     * @return {double} the bound, at most proven_weight.
+     * @private
+     */
+    double CalculateBound_(double proven_weight) const;
+
+    /**
+     * Checks if the search has used up its time or boards.
+     * @return {boolean} true if the budget ran out.
+     * @private
+     */
+    bool IsOverBudget_();
+
+    /**
+     * Follows the moves back from the goal state to the initial board, and
+     * keeps the solution with its bound.
+     * @param {Board} scratch A board that is moved to follow the moves.
+     * @param {double} proven_weight The weight of the last round that ran
+     *   to the end.
+     * @private
+     */
+    void RecordSolution_(Board<W, H> &scratch, double proven_weight);
+};
+
+#endif
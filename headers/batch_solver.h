@@ -0,0 +1,145 @@
+//////////////////////////////////////////
+// Assignment 1 : Lucas Silva           //
+// The header file for the batch solver //
+//////////////////////////////////////////
+
+#ifndef _batch_solver_h
+#define _batch_solver_h
+
+#include <cstddef>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "distance_table.h"
+#include "solution_cache.h"
+#include "solver.h"
+
+/*
+    Solves many boards in one run, on a pool of threads. Boards are read
+    either one per line, or in the "Case N:" / "Input:" layout of the test
+    case files. Each thread has its own queue of boards, and a thread that
+    runs out takes boards from the back of another thread's queue, so a
+    few hard boards don't leave the other threads idle. Every thread keeps
+    its own Solver for its whole run, and they can share a cache of
+    solutions. A line of result is written for each board, in the order
+    the boards were read, as soon as every board before it is done.
+    The heuristic is whatever was set on the Board classes beforehand.
+    Below is a list of its private data members and their default value:
+        - {SolveOptions}       options_       -> initialized to the given value
+        - {int}                threads_       -> initialized to the given value
+        - {DistanceTable}      table_         -> initialized to the given table
+        - {SolutionCache*}     cache_         -> initialized to the given value
+        - {vector<string>}     names_         -> initialized to empty
+        - {vector<string>}     inputs_        -> initialized to empty
+        - {vector<string>}     results_       -> initialized to empty
+        - {vector<bool>}       finished_      -> initialized to empty
+        - {vector<WorkQueue*>} queues_        -> initialized to empty
+        - {ostream*}           out_           -> initialized to NULL
+        - {size_t}             next_to_write_ -> initialized to zero
+        - {int}                solved_        -> initialized to zero
+*/
+class BatchSolver {
+ public:
+    /*
+     * Constructor for the BatchSolver class.
+     * @param {SolveOptions} options How to solve every board.
+     * @param {int} threads The number of threads to solve on.
+     * @param {DistanceTable} table The distance table, used by TABLE_WALK.
+     * @param {SolutionCache*} cache The cache of solutions, NULL if there
+     *   is none.
+     */
+    BatchSolver(const SolveOptions &options, int threads,
+                const DistanceTable &table, SolutionCache* cache) :
+        options_(options), threads_(threads), table_(table), cache_(cache),
+        out_(NULL), next_to_write_(0), solved_(0) {}
+
+    /**
+     * Reads the boards from a stream. In the test case layout, the rows
+     * after each "Input:" line make up a board, and everything else is
+     * ignored. Otherwise every line that isn't blank is a board.
+     * @param {istream} in The stream to read from.
+     * @param {vector<string>} names Filled with a name for each board.
+     * @param {vector<string>} inputs Filled with the tiles of each board.
+     */
+    static void ReadBoards(std::istream &in, std::vector<std::string> &names,
+                           std::vector<std::string> &inputs);
+
+    /**
+     * Solves every board read from a stream, and writes a line for each one
+     * in the same order: its name, then the number of moves and the
+     * direction of each move (R, L, U or D for where the empty space went),
+     * or why it wasn't solved, as Solver::WriteResult does.
+     * @param {istream} in The stream to read the boards from.
+     * @param {ostream} out The stream to write the results to.
+     * @return {int} the number of boards solved.
+     */
+    int Run(std::istream &in, std::ostream &out);
+
+ private:
+    /* A queue of board indices, and the lock that guards it. */
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<size_t> boards;
+    };
+
+    /* How every board is solved. */
+    SolveOptions options_;
+    /* The number of threads to solve on. */
+    int threads_;
+    /* The distance table, used by TABLE_WALK. */
+    const DistanceTable &table_;
+    /* The cache of solutions shared by the threads. */
+    SolutionCache* cache_;
+    /* The name and tiles of each board, in the order they were read. */
+    std::vector<std::string> names_;
+    std::vector<std::string> inputs_;
+    /* The line of result of each board, once it is done. */
+    std::vector<std::string> results_;
+    std::vector<bool> finished_;
+    /* One queue of boards for each thread. */
+    std::vector<WorkQueue*> queues_;
+    /* Guards the results, and everything below. */
+    std::mutex results_mutex_;
+    /* The stream the results are written to. */
+    std::ostream* out_;
+    /* The first board whose result hasn't been written yet. */
+    size_t next_to_write_;
+    /* The number of boards solved. */
+    int solved_;
+
+    /**
+     * Solves boards until every queue is empty.
+     * @param {int} thread The index of the thread, and of its own queue.
+     * @private
+     */
+    void Work_(int thread);
+
+    /**
+     * Takes the next board for a thread, from the front of its own queue,
+     * or else from the back of another thread's queue.
+     * @param {int} thread The index of the thread.
+     * @param {size_t} board Set to the index of the board taken.
+     * @return {boolean} false if every queue is empty.
+     * @private
+     */
+    bool TakeBoard_(int thread, size_t &board);
+
+    /**
+     * Stores the result of a board, and writes every result that is next
+     * in order.
+     * @param {size_t} board The index of the board.
+     * @param {string} result The line of result, without the name.
+     * @param {boolean} solved true if the board was solved.
+     * @private
+     */
+    void Finish_(size_t board, const std::string &result, bool solved);
+
+    // The solver holds locks, so it cannot be copied.
+    BatchSolver(const BatchSolver &);
+    BatchSolver& operator=(const BatchSolver &);
+};
+
+#endif
@@ -0,0 +1,216 @@
+//////////////////////////////////////////////////
+// Assignment 1 : Lucas Silva                   //
+// The header file for the bidirectional search //
+//////////////////////////////////////////////////
+
+#ifndef _bidirectional_search_h
+#define _bidirectional_search_h
+
+#include <cstddef>
+#include <queue>
+#include <unordered_map>
+#include <vector>
+
+#include "board.h"
+#include "move_sequence.h"
+#include "packed_state.h"
+#include "search_stats.h"
+
+/*
+    A bidirectional search that meets in the middle (MM). One search goes
+    forward from the initial board towards its goal state, with the
+    board's own heuristic, and another goes backward from the goal state
+    towards the initial board, with the manhattan distance to the initial
+    board. A board is taken off an open list in order of
+    max(rank, 2 * moves made), so neither search goes past the middle of a
+    solution before the other one has caught up. Every time a new board
+    is reached by one search that the other one has reached too, the two
+    halves make a solution. The search stops as soon as nothing left on
+    either open list could make a shorter one, so the solution is optimal.
+    Below is a list of its private data members and their default value:
+        - {Side[2]}      sides_         -> initialized to empty
+        - {int[]}        start_cell_    -> initialized to zero
+        - {int}          best_moves_    -> initialized to -1
+        - {SearchStats}  stats_         -> initialized to zero
+        - {State}        meeting_state_ -> initialized to empty
+        - {MoveSequence} path_          -> initialized to empty
+*/
+template <int W, int H>
+class BidirectionalSearch {
+ public:
+    /* The packed representation of the tiles. */
+    typedef PackedState<W * H> State;
+
+    /*
+     * Constructor for the BidirectionalSearch class.
+     */
+    BidirectionalSearch() : start_cell_(), best_moves_(-1) {}
+
+    /**
+     * Searches for a shortest solution from the given board.
+     * @param {Board} board The initial board, must have been created.
+     * @return {boolean} true if a solution was found.
+     */
+    bool Solve(const Board<W, H> &board);
+
+    /**
+     * Gets the moves of the solution found by Solve.
+     * @return {MoveSequence} the moves, from the initial board on.
+     */
+    const MoveSequence& GetPath() const {return this->path_;}
+
+    /**
+     * Gets the number of boards the last search expanded going forward,
+     * from the initial board.
+     * @return {long} the number of boards expanded.
+     */
+    long GetForwardNodesExpanded() const {
+        return this->sides_[FORWARD_].expanded;}
+
+    /**
+     * Gets the number of boards the last search expanded going backward,
+     * from the goal state.
+     * @return {long} the number of boards expanded.
+     */
+    long GetBackwardNodesExpanded() const {
+        return this->sides_[BACKWARD_].expanded;}
+
+    /**
+     * Gets what the last search did, both ways together. The peak size
+     * is of both open lists at once.
+     * @return {SearchStats} the statistics of the last search.
+     */
+    const SearchStats& GetStats() const {return this->stats_;}
+
+    /**
+     * Gets the number of distinct states the last search reached, counting
+     * a state reached from both ends twice.
+     * @return {size_t} the number of states reached.
+     */
+    size_t GetStatesReached() const {
+        return this->sides_[FORWARD_].nodes.size() +
+            this->sides_[BACKWARD_].nodes.size();}
+
+ private:
+    /* The two searches. */
+    static const int FORWARD_ = 0;
+    static const int BACKWARD_ = 1;
+
+    /* A state one of the searches reached. */
+    struct Node {
+        /* The fewest moves it was reached in from where the search began. */
+        int moves_made;
+        /* The estimated number of moves to where the search is going. */
+        int estimated_moves_remaining;
+        /* The direction of the move that reached it, -1 for the first. */
+        int direction;
+        /* true while it is on the open list. */
+        bool open;
+    };
+
+    /* An open list entry, for a node that may since have been improved. */
+    struct OpenEntry {
+        int priority;
+        int moves_made;
+        State state;
+    };
+
+    /* Orders the open list by priority, then by most moves made. */
+    struct OpenEntryCompare {
+        bool operator()(const OpenEntry &lhs, const OpenEntry &rhs) const {
+            if (lhs.priority != rhs.priority) {
+                return lhs.priority > rhs.priority;
+            }
+            return lhs.moves_made < rhs.moves_made;
+        }
+    };
+
+    /* Hashes states for the node tables. */
+    struct StateHash {
+        size_t operator()(const State &state) const {
+            return static_cast<size_t>(state.Hash());
+        }
+    };
+
+    /* Everything one of the two searches keeps. */
+    struct Side {
+        /* Every state reached, open or not. */
+        std::unordered_map<State, Node, StateHash> nodes;
+        /* The open list. */
+        std::priority_queue<OpenEntry, std::vector<OpenEntry>,
+                            OpenEntryCompare> open;
+        /* The number of open nodes with each rank, and with each number
+           of moves made, for the lower bounds on a solution. */
+        std::vector<long> open_ranks;
+        std::vector<long> open_moves;
+        /* The number of boards expanded. */
+        long expanded;
+    };
+
+    /* The forward and the backward search. */
+    Side sides_[2];
+    /* The cell each tile is in on the initial board. */
+    int start_cell_[W * H];
+    /* The fewest moves of a solution found so far, -1 if there is none. */
+    int best_moves_;
+    /* What the search did, both ways together. */
+    SearchStats stats_;
+    /* The state where the two halves of that solution meet. */
+    State meeting_state_;
+    /* The moves of the last solution. */
+    MoveSequence path_;
+
+    /**
+     * Gets the sum of manhattan distances from a state to the initial board.
+     * @param {State} state The state.
+     * @return {int} the estimated number of moves back to the initial board.
+     * @private
+     */
+    int DistanceToStart_(const State &state) const;
+
+    /**
+     * Puts a state reached by one of the searches on its open list, unless
+     * it was already reached in as few moves, and checks if the other
+     * search has reached it too.
+     * @param {int} side FORWARD_ or BACKWARD_.
+     * @param {State} state The state.
+     * @param {int} moves_made The number of moves made to reach it.
+     * @param {int} estimated_moves_remaining The heuristic of the state.
+     * @param {int} direction The direction of the move that reached it.
+     * @private
+     */
+    void Reach_(int side, const State &state, int moves_made,
+                int estimated_moves_remaining, int direction);
+
+    /**
+     * Takes the best board off one of the open lists and reaches the
+     * boards one move away from it.
+     * @param {int} side FORWARD_ or BACKWARD_.
+     * @param {Board} scratch A board that is moved to find the new states.
+     * @private
+     */
+    void Expand_(int side, Board<W, H> &scratch);
+
+    /**
+     * Drops the entries at the top of an open list that were improved on
+     * after they were put there.
+     * @param {int} side FORWARD_ or BACKWARD_.
+     * @return {boolean} true if the open list isn't empty.
+     * @private
+     */
+    bool SkipStaleEntries_(int side);
+
+    /**
+     * Follows the moves of one of the searches back from the meeting state
+     * to where that search began.
+     * @param {int} side FORWARD_ or BACKWARD_.
+     * @param {Board} scratch A board that is moved to follow the moves.
+     * @param {vector<int>} directions Filled with the directions of the
+     *   moves, from the meeting state back.
+     * @private
+     */
+    void FollowMovesBack_(int side, Board<W, H> &scratch,
+                          std::vector<int> &directions) const;
+};
+
+#endif
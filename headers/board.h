@@ -8,30 +8,116 @@
 
 #include <string>
 #include <utility>
+#include <vector>
+
+#include "goal_state.h"
+#include "move_sequence.h"
+#include "packed_state.h"
+
+template <int W, int H> class PatternDatabase;
+
+/**
+ * Splits the user input into tile values. Tiles are separated by white
+ * space, so they can have more than one digit. Input without any white
+ * space is read one digit per tile, which only works for the 8-puzzle.
+ * @param {string} input The user input.
+ * @param {vector<int>} tiles Filled with the tile values, row by row.
+ * @return {boolean} false if something other than a number was found.
+ */
+bool ParseTiles(const std::string &input, std::vector<int> &tiles);
+
+/*
+    What every board of a puzzle has in common: the input it was created
+    from and the goal states it is solved towards. The initial board and
+    every copy of it point to the same one, so copying a board only copies
+    the tiles and the moves made.
+    Below is a list of its data members and their default value:
+        - {int}          kMaxGoals (static) -> 4
+        - {string}       input              -> initialized to the user input
+        - {int}          goal_state_type    -> initialized to -1
+        - {int}          goal_count         -> initialized to zero
+        - {GoalState*[]} goals              -> initialized to NULL
+*/
+template <int W, int H>
+struct ProblemContext {
+    /* The most goal states a board can be solved towards at once. */
+    static const int kMaxGoals = 4;
+
+    /* The input string given by the user. */
+    std::string input;
+    /* The type of the goal states: TOP_LEFT or BOTTOM_RIGHT, EITHER_GOAL
+       when both of those are, or CUSTOM_GOAL for goals the user gave. */
+    int goal_state_type;
+    /* The number of goal states. */
+    int goal_count;
+    /* The goal states, whichever is reached first ends the search. */
+    const GoalState<W, H>* goals[kMaxGoals];
+
+    explicit ProblemContext(const std::string &input) : input(input),
+        goal_state_type(-1), goal_count(0), goals() {}
+};
 
 /*
 	The board class stores the states of the board and provides a way to interact with 
-	the board by making moves.
+	the board by making moves. The width W and height H of the board are
+	fixed at compile time, so the 8-puzzle is a Board<3, 3> and the
+	15-puzzle a Board<4, 4>.
     Below is a list of its private data members and their default value:
-        - {string}         input_string_                  -> initialized to user input
+        - {ProblemContext*} created_problem_              -> initialized to user input
+        - {boolean}        owns_problem_                  -> initialized to true
+        - {ProblemContext*} problem_                      -> initialized to created_problem_
         - {int}            moves_made_                    -> initialized to zero
         - {int}            direction_moved_               -> initialized to -1
         - {int}            estimated_moves_remaining_     -> initialized to -1
-        - {int}            previous_state_                -> initialized to NULL
-        - {int**}          board_                         -> initialized to NULL
-        - {int}            goal_state_type_               -> initialized to -1
-        - {pair<int, int>} empty_space_position_          -> initialized to (-1,-1) 
+        - {State}          state_                         -> initialized to empty
+        - {short[]}        goal_estimates_                -> initialized to zero
+        - {unsigned char[][]} line_conflicts_             -> initialized to zero
+        - {PatternDatabase*} pattern_database_ (static)   -> initialized to NULL
+        - {boolean}        use_linear_conflict_ (static)  -> initialized to false
+        - {vector<GoalState>*} custom_goals_ (static)     -> initialized to NULL
 */
+template <int W, int H>
 class Board {
  public:
+    /* Number of columns on the board. */
+    static const int kWidth = W;
+    /* Number of rows on the board. */
+    static const int kHeight = H;
+    /* Number of cells on the board. */
+    static const int kCells = W * H;
+
+    /* The packed representation of the tiles. */
+    typedef PackedState<W * H> State;
+
  	/*
- 	 * Constructor for the Board class. 
+ 	 * Constructor for the Board class. The board makes and owns the
+ 	 * problem context for the input.
  	 * @param {string} input The user input
  	 */
-    explicit Board(const std::string &input) : input_string_(input),
-      moves_made_(0), direction_moved_(-1), estimated_moves_remaining_(-1),
-      previous_state_(NULL), board_(NULL), goal_state_type_(-1),
-      empty_space_position_(std::make_pair(-1, -1)) {}
+    explicit Board(const std::string &input) :
+      created_problem_(new ProblemContext<W, H>(input)),
+      owns_problem_(true), problem_(created_problem_), moves_made_(0),
+      estimated_moves_remaining_(-1), direction_moved_(-1),
+      goal_estimates_(), line_conflicts_() {}
+
+ 	/*
+ 	 * Constructor for a board whose problem context is owned by the caller,
+ 	 * which must keep it until this board and its copies are gone.
+ 	 * @param {ProblemContext*} problem The context, holding the user input.
+ 	 */
+    explicit Board(ProblemContext<W, H>* problem) :
+      created_problem_(problem), owns_problem_(false), problem_(problem),
+      moves_made_(0), estimated_moves_remaining_(-1), direction_moved_(-1),
+      goal_estimates_(), line_conflicts_() {}
+
+    /**
+     * Destructor for the board class.
+     */
+    ~Board() {
+        if (this->owns_problem_) {
+            delete this->created_problem_;
+        }
+    }
 
     /**
      * Copy constructor for the board class.
@@ -39,10 +125,13 @@ class Board {
      */
     Board(const Board& board);
 
-    /*
-     * Destructor for the Board class. Deallocates dyanmically created memory.
+    /**
+     * Assignment operator for the board class.
+     * @param {Board} the board to be copied
+     * @return {Board} this board
      */
-    ~Board() {this->DestroyBoard_();}
+    Board& operator=(const Board& board);
+
 
     /////////////////////////////////////
     // Getters for all private members //
@@ -55,38 +144,39 @@ class Board {
     const int GetMovesMade() const {return this->moves_made_;}
 
     /**
-     * Gets the estimated number of moves remaining, sum of manhattan distances.
+     * Gets the estimated number of moves remaining to the closest goal
+     * state, the least of the heuristic over every goal state.
      * @return {int} the estimated number of moves remaining, used as heuristic.
      */
     const int GetEstimatedMovesRemaining() const {
         return this->estimated_moves_remaining_;}
 
     /**
-     * Gets a pointer to the previous board state.
-     * @return {Board*} the previous state.
+     * Gets the direction of the last move made.
+     * @return {int} the direction, or -1 if it isn't known.
      */
-    Board* GetPreviousState() {return this->previous_state_;}
+    const int GetDirectionMoved() const {return this->direction_moved_;}
 
     /**
      * Gets the position of empty space as a pair of coordinates.
      * @return {pair<int, int>} (x,y) coordinates of the empty space.
      */
     const std::pair<int, int> GetEmptySpacePosition() const {
-        return this->empty_space_position_;}
+        return std::make_pair(this->state_.blank / W, this->state_.blank % W);}
 
     /**
      * Gets the x coordinate of the empty space.
      * @return {int} the x coordinate of the empty space.
      */
     const int GetEmptySpaceRow() const {
-        return this->empty_space_position_.first;}
+        return this->state_.blank / W;}
 
     /**
      * Gets the y coordinate of the empty space.
      * @return {int} the y coordinate of the empty space.
      */
     const int GetEmptySpaceColumn() const {
-        return this->empty_space_position_.second;}
+        return this->state_.blank % W;}
 
     /**
      * Returns the value of the tile at board[x][y]
@@ -96,6 +186,40 @@ class Board {
      */
     const int GetValueAt(int x, int y) const;
 
+    /**
+     * Gets the packed representation of the tiles on the board.
+     * @return {State} the packed board state.
+     */
+    const State& GetState() const {return this->state_;}
+
+    /**
+     * Gets the type of the goal states the board is being solved towards.
+     * @return {int} TOP_LEFT, BOTTOM_RIGHT, EITHER_GOAL or CUSTOM_GOAL.
+     */
+    const int GetGoalStateType() const {
+        return this->problem_->goal_state_type;}
+
+    /**
+     * Gets the number of goal states the board is being solved towards.
+     * @return {int} the number of goal states.
+     */
+    const int GetGoalCount() const {return this->problem_->goal_count;}
+
+    /**
+     * Gets one of the goal states the board is being solved towards.
+     * @param {int} goal The index of the goal state.
+     * @return {GoalState} the goal state.
+     */
+    const GoalState<W, H>& GetGoal(int goal) const {
+        return *this->problem_->goals[goal];}
+
+    /**
+     * Gets what this board has in common with every other board of the
+     * puzzle.
+     * @return {ProblemContext} the problem context.
+     */
+    const ProblemContext<W, H>& GetProblem() const {return *this->problem_;}
+
     /**
      * Returns the sum of the actual moves made plus 
      *   the estimated number of moves remaining.
@@ -108,9 +232,6 @@ class Board {
     // End of getters //
     ////////////////////
 
-    /* Sets the pointer to the previous board state */
-    void SetPreviousState(Board* &prev) {this->previous_state_ = prev;}
-
     /**
      * Checks if a board has been allocated and initialized.
      * @return {boolean} true if board is valid.
@@ -118,16 +239,16 @@ class Board {
     bool IsValid() const;
 
     /**
-     * Checks if the board is at the goal state.
+     * Checks if the board is at any of its goal states.
      * @return {boolean} true if board is at goal state.
      */
     bool IsAtGoalState() const {return this->estimated_moves_remaining_ == 0;}
 
     /*
-     * Allocates memory and initializes the board. 
+     * Initializes the board from the user input.
      * Must be called after making a new board instance, because this
      * actually initializes the private members to match the user input.
-     * @return {boolean} true if allocation successful, false otherwise.
+     * @return {boolean} true if the input was valid, false otherwise.
      */
     bool CreateBoard();
 
@@ -137,21 +258,61 @@ class Board {
     void PrintBoard() const;
 
     /**
-     * Displays all the previous board states, in order.
+     * Displays every board of a solution, in order, by replaying its moves
+     * from this board.
+     * @param {MoveSequence} moves The moves of the solution.
      */
-    void DisplayAllSteps();
+    void DisplaySolution(const MoveSequence &moves) const;
+
+    /**
+     * Checks that a solution is made of legal moves, and that they take
+     * this board to its goal state.
+     * @param {MoveSequence} moves The moves of the solution.
+     * @return {boolean} true if the moves solve the board.
+     */
+    bool IsSolvedBy(const MoveSequence &moves) const;
 
     /**
      * Gets the value of the heuristic function.
-     * @return {int} The sum of the manhattan distances of all the tiles.
+     * @return {int} The sum of the manhattan distances of all the tiles,
+     *   or the pattern database estimate when one is set.
      */
     int GetHeuristicValue();
 
     /**
-     * Determines if the board is solvable.
+     * Sets the pattern database used as the heuristic by every board of
+     * this size, instead of the manhattan distances. Must be set before
+     * boards are created, and stay alive while they are used.
+     * @param {PatternDatabase*} database The database, or NULL to go back
+     *   to the manhattan distances.
+     */
+    static void SetPatternDatabase(const PatternDatabase<W, H>* database) {
+        pattern_database_ = database;}
+
+    /**
+     * Sets whether every board of this size adds the linear conflicts to
+     * the manhattan distances. Must be set before boards are created.
+     * @param {boolean} use_linear_conflict true to add them.
+     */
+    static void SetLinearConflict(bool use_linear_conflict) {
+        use_linear_conflict_ = use_linear_conflict;}
+
+    /**
+     * Sets the goal states every board of this size is solved towards,
+     * instead of the two standard ones. Must be set before boards are
+     * created, and stay alive while they are used. A board is solved
+     * towards those of them it can reach.
+     * @param {vector<GoalState>*} goals At most kMaxGoals goal states, or
+     *   NULL to go back to the standard ones.
+     */
+    static void SetCustomGoals(const std::vector<GoalState<W, H> >* goals) {
+        custom_goals_ = goals;}
+
+    /**
+     * Determines if a goal state can be reached from the board.
      * @return {boolean} true if solvable, false otherwise.
      */
-    bool IsSolvable();
+    bool IsSolvable() const;
 
     /**
      * Determine whether a move to the right is possible.
@@ -201,88 +362,182 @@ class Board {
      */
     bool MoveUp();
 
+    /**
+     * Moves the empty space in the given direction, if possible, like the
+     * Move* methods, with a single table lookup.
+     * @param {int} direction RIGHT, LEFT, UP or DOWN.
+     * @return {boolean} true if the move was made.
+     */
+    bool MoveInDirection(int direction);
+
+    /**
+     * Takes back a move in the given direction, which must have been the
+     * last move made. Used to search in place on a single board.
+     * @param {int} direction The direction of the move being taken back.
+     */
+    void UndoMove(int direction);
+
+    /**
+     * Makes the state of every board one move away from this one, and
+     * estimates the moves remaining from all of them at once. With the
+     * manhattan distance to a single goal state each estimate is a lookup.
+     * Otherwise, on boards of up to 16 cells without a pattern database,
+     * they are scored together by the heuristic kernel, and else the board
+     * is moved to each of them and back. Either way it ends in the state
+     * it started.
+     * @param {State[]} children Filled with the states, at most 4.
+     * @param {int[]} directions Filled with the direction of each move,
+     *   in the order RIGHT, LEFT, UP, DOWN.
+     * @param {int[]} estimates Filled with the heuristic of each state.
+     * @return {int} the number of boards one move away.
+     */
+    int GetChildren(State children[4], int directions[4], int estimates[4]);
+
+    /**
+     * Like GetChildren, for the moves in the given directions only. With
+     * the manhattan distance to a single goal state, the estimate of each
+     * board only changes by the distance of the tile that moves, so it is
+     * a lookup for each move, and no board is scored.
+     * @param {int[]} directions The directions, each a possible move.
+     * @param {int} count The number of directions, at most 4.
+     * @param {State[]} children Filled with the states.
+     * @param {int[]} estimates Filled with the heuristic of each state.
+     */
+    void GetChildrenInDirections(const int* directions, int count,
+                                 State children[4], int estimates[4]);
+
+    /**
+     * Puts the board in another state of the same puzzle, towards the same
+     * goal state, and recalculates the heuristic. Used by searches that
+     * keep states instead of boards.
+     * @param {State} state The state, must be reachable from this one.
+     * @param {int} moves_made The number of moves made to reach it.
+     */
+    void SetState(const State &state, int moves_made);
+
+    /**
+     * Puts the board in another state of the same puzzle, like SetState,
+     * with a heuristic that is already known. Used by searches that keep
+     * the heuristic of every state they reach.
+     * @param {State} state The state, must be reachable from this one.
+     * @param {int} moves_made The number of moves made to reach it.
+     * @param {int} estimated_moves_remaining The heuristic of the state.
+     */
+    void SetState(const State &state, int moves_made,
+                  int estimated_moves_remaining);
+
  private:
-    /* The input string given by the user. */
-    std::string input_string_;
-    /* Representation of a board as a dynamically allocated 2-D array */
-    int** board_;
-    /* (X,Y) position of the empty space on the board */
-    std::pair<int, int> empty_space_position_;
+    /* The context CreateBoard fills in, NULL on copies. */
+    ProblemContext<W, H>* created_problem_;
+    /* Whether the board made its context and must delete it. */
+    bool owns_problem_;
+    /* The input and goal state, pointed to by every copy of the board. */
+    const ProblemContext<W, H>* problem_;
+    /* The packed tiles, with the empty space cached */
+    State state_;
     /* Actual number of moves made so far */
     int moves_made_;
     /* Estimated moves remaining, using heuristic function. */
     int estimated_moves_remaining_;
     /* Stores the direction that the board was moved */
     int direction_moved_;
-    /* Stores the type of the goal state, top left versus bottom right */
-    int goal_state_type_;
-    /* A pointer to the previous board state. */
-    Board* previous_state_;
-
-    /* Free dynamically allocated memory for board. */
-    void DestroyBoard_();
 
-    /* Allocates dynamic memory used to store the board. */
-    bool AllocateBoard_();
-
-    /* Sets the x position of the blank space on the board */
-    void SetEmptySpaceXCoordinate_(int x) {
-        this->empty_space_position_.first = x;}
-
-    /* Sets the y position of the blank space on the board */
-    void SetEmptySpaceYCoordinate_(int y) {
-        this->empty_space_position_.second = y;}
-
-    /* Removes all spaces from input string */
-    std::string TrimSpaceFromInputString_();
+    /* The heuristic towards each goal state, or kUnknownEstimate first if
+       only the least of them is known since SetState. */
+    short goal_estimates_[ProblemContext<W, H>::kMaxGoals];
+    static const short kUnknownEstimate = -1;
+    /* For each goal state, and for each row and then each column, how
+       many of its tiles must leave it to let the others past, when linear
+       conflicts are used, or kUnknownConflicts if it hasn't been counted
+       since SetState. */
+    unsigned char line_conflicts_[ProblemContext<W, H>::kMaxGoals][W + H];
+    static const unsigned char kUnknownConflicts = 0xff;
+
+    /* The heuristic for every board of this size, NULL for manhattan. */
+    static const PatternDatabase<W, H>* pattern_database_;
+    /* true to add the linear conflicts to the manhattan distances. */
+    static bool use_linear_conflict_;
+    /* The goal states the user gave for this size, NULL for the standard
+       ones. */
+    static const std::vector<GoalState<W, H> >* custom_goals_;
 
     /*
-     * Calculates the sum of all manhattan distances of every piece on the board.
-     * This is the heuristic function used for the A* algorithm.
+     * Calculates the sum of the manhattan distances of every piece on the
+     * board from where it belongs in a goal state.
+     * @param {GoalState} goal The goal state.
      * @return the sum of the manhattan distances.
      */
-    int CalculateSumOfManhattanDistances_();
+    int CalculateSumOfManhattanDistances_(const GoalState<W, H> &goal) const;
 
     /**
-     * Calculates the manhattan distance with the goal state represented by
-     * the empty state at the top left.
-     * @return the sum of the manhattan distances.
+     * Counts the linear conflicts in a row or column: the tiles in it that
+     * belong in it, but are in the way of each other. The fewest tiles that
+     * must leave the line so the rest are in order each cost two extra
+     * moves on top of the manhattan distances.
+     * @param {int} goal The index of the goal state.
+     * @param {int} line A row, or H plus a column.
+     * @return {int} the number of tiles that must leave the line.
+     * @private
      */
-    int CalculateSumOfManhattanDistancesTop_();
+    int CountLineConflicts_(int goal, int line) const;
 
     /**
-     * Calculates the manhattan distance with the goal state represented by
-     * the empty state at the bottom right.
-     * @return the sum of the manhattan distances.
+     * Counts the linear conflicts of every row and column into
+     * line_conflicts_.
+     * @param {int} goal The index of the goal state.
+     * @return {int} the number of tiles that must leave their line.
+     * @private
      */
-    int CalculateSumOfManhattanDistancesBottom_();
+    int CalculateLineConflicts_(int goal);
 
     /**
      * Recalculates the heuristic function, which estimates how many
-     *   moves remain to get to goal state.
-     *   Also sets estimated_moves_remaining_;
+     *   moves remain to get to the closest goal state.
+     *   Also sets estimated_moves_remaining_ and goal_estimates_;
      * @private
      */
     int CalculateAndSetHeuristic_();
 
     /**
-     * Swaps the values of two coordinates on the board with each other.
-     * @param {pair<int, int>} The first point.
-     * @param {pair<int, int>} The second point.
+     * Swaps the values of two cells on the board with each other.
+     * @param {int} The first cell (row * W + column).
+     * @param {int} The second cell (row * W + column).
      * @private
      */
-    void Swap_(std::pair<int, int> point_1, std::pair<int, int> point_2);
+    void Swap_(int cell_1, int cell_2);
 
     /**
-     * Actually moves the white space on the board.
+     * Actually moves the white space on the board, and counts the move.
      * @param {int} direction The direction of the move.
      * @private
      */
     void Move_(int direction);
 
     /**
-     * Determines the goal state can be reached in the least 
-     * number of moves using the heuristic.
+     * Moves the white space on the board without counting a move, and
+     *   updates the heuristic by the change in distance of the one tile
+     *   that moved, or in the estimate of its group. Compile with
+     *   CHECK_INCREMENTAL_HEURISTIC defined to check the update against a
+     *   full recalculation after every move.
+     * @param {int} direction The direction the white space moves in.
+     * @private
+     */
+    void Slide_(int direction);
+
+    /**
+     * Determines if a goal state can be reached from the board, which is
+     * when both have the same parity, as given by GoalState::GetParity.
+     * @param {GoalState} goal The goal state.
+     * @return {boolean} true if the goal state can be reached.
+     * @private
+     */
+    bool IsSolvableForGoal_(const GoalState<W, H> &goal) const;
+
+    /**
+     * Determines the goal states the board is solved towards: every one
+     * of the custom goal states, or of the two standard ones, that can be
+     * reached from it. Only one of the standard goal states can be
+     * reached on boards of even width.
      * @private
      */
     void DetermineGoalState_();
@@ -294,7 +549,11 @@ class Board {
  * @param {Board} rhs The right hand side of the ==
  * @return {boolean} true if board states are equal.
  */
-bool operator==(const Board &lhs, const Board &rhs);
+template <int W, int H>
+inline bool operator==(const Board<W, H> &lhs, const Board<W, H> &rhs) {
+    // Both boards are packed into a few words, so compare those.
+    return lhs.GetState() == rhs.GetState();
+}
 
 /**
  * Overloaded less than operator. 
@@ -303,6 +562,9 @@ bool operator==(const Board &lhs, const Board &rhs);
  * @return {boolean} true if overall rank of the board on the left
  *   is less than the one on the right. (using GetRank())
  */
-bool operator<(const Board &lhs, const Board &rhs);
+template <int W, int H>
+inline bool operator<(const Board<W, H> &lhs, const Board<W, H> &rhs) {
+    return lhs.GetRank() > rhs.GetRank();
+}
 
 #endif
@@ -0,0 +1,116 @@
+//////////////////////////////////////////
+// Assignment 1 : Lucas Silva           //
+// The header file for the bucket queue //
+//////////////////////////////////////////
+
+#ifndef _bucket_queue_h
+#define _bucket_queue_h
+
+#include <stdint.h>
+#include <cstddef>
+#include <vector>
+
+#include "packed_state.h"
+
+/*
+    An entry of an open list of the A* search: a board that was reached but
+    not expanded yet, as its state, the index of the search node it is
+    recorded under, and the rank and moves made it is ordered by. It holds
+    everything needed to expand the board, so the search only keeps how
+    each board was reached once it is taken off the open list.
+    Below is a list of its data members and their default value:
+        - {State}    state      -> initialized to empty
+        - {uint32_t} node       -> not initialized
+        - {uint16_t} rank       -> not initialized
+        - {uint16_t} moves_made -> not initialized
+*/
+template <int W, int H>
+struct OpenEntry {
+    PackedState<W * H> state;
+    /* The index of the node in the search. */
+    uint32_t node;
+    /* Moves made + estimated moves remaining. */
+    uint16_t rank;
+    uint16_t moves_made;
+};
+
+/*
+    An open list for the A* search made of buckets, one per rank
+    (moves made + estimated moves remaining). Since the rank is a small
+    integer, pushing is an append to a bucket and popping takes from the
+    lowest non-empty bucket, instead of sifting through a heap.
+    Within a bucket, boards are split again by moves made, and the board
+    with the most moves made comes out first, since it is the closest to
+    the goal. It has the same interface as the std::priority_queue used
+    by Solve, so either one can be plugged in.
+    Below is a list of its private data members and their default value:
+        - {vector<vector<vector<OpenEntry> > >} buckets_   -> initialized to empty
+        - {vector<size_t>}                      counts_    -> initialized to empty
+        - {size_t}                              size_      -> initialized to zero
+        - {int}                                 min_rank_  -> initialized to zero
+        - {int}                                 max_moves_ -> initialized to -1
+*/
+template <int W, int H>
+class BucketQueue {
+ public:
+    /*
+     * Constructor for the BucketQueue class.
+     */
+    BucketQueue() : size_(0), min_rank_(0), max_moves_(-1) {}
+
+    /**
+     * Checks if there are no boards in the queue.
+     * @return {boolean} true if the queue is empty.
+     */
+    bool empty() const {return this->size_ == 0;}
+
+    /**
+     * Gets the number of boards in the queue.
+     * @return {size_t} the number of boards.
+     */
+    size_t size() const {return this->size_;}
+
+    /**
+     * Adds a board to the bucket for its rank.
+     * @param {OpenEntry} entry The board to be added.
+     */
+    void push(const OpenEntry<W, H> &entry);
+
+    /**
+     * Gets the board with the lowest rank, and the most moves made among
+     * those. The queue must not be empty.
+     * @return {OpenEntry} the board.
+     */
+    const OpenEntry<W, H>& top();
+
+    /**
+     * Removes the board returned by top. The queue must not be empty.
+     */
+    void pop();
+
+    /**
+     * Removes every board, keeping the memory of the buckets for the next
+     * search.
+     */
+    void clear();
+
+ private:
+    /* The boards, indexed by rank and then by moves made. */
+    std::vector<std::vector<std::vector<OpenEntry<W, H> > > > buckets_;
+    /* The number of boards with each rank. */
+    std::vector<size_t> counts_;
+    /* The total number of boards. */
+    size_t size_;
+    /* The lowest rank that may have a board, nothing is below it. */
+    int min_rank_;
+    /* The moves made of the next board out, -1 if it must be looked up. */
+    int max_moves_;
+
+    /**
+     * Moves min_rank_ and max_moves_ to the bucket of the next board out.
+     * @private
+     */
+    void Settle_();
+};
+
+#endif
@@ -0,0 +1,117 @@
+////////////////////////////////////////
+// Assignment 1 : Lucas Silva         //
+// The header file for the closed set //
+////////////////////////////////////////
+
+#ifndef _closed_set_h
+#define _closed_set_h
+
+#include <stdint.h>
+#include <cstddef>
+#include <vector>
+
+#include "packed_state.h"
+
+/*
+    The closed set remembers every board state the search has reached, along
+    with the fewest moves it took to get there. A state reached again with
+    at least as many moves can never lead to a shorter solution, so the
+    search drops it instead of expanding it a second time.
+    It is an open addressing hash table keyed on the packed board words,
+    for boards of W by H tiles.
+    Below is a list of its private data members and their default value:
+        - {vector<Entry>} entries_             -> initialized to kInitialCapacity
+        - {size_t}        size_                -> initialized to zero
+        - {long}          duplicates_pruned_   -> initialized to zero
+        - {long}          stale_nodes_skipped_ -> initialized to zero
+*/
+template <int W, int H>
+class ClosedSet {
+ public:
+    /* The packed representation of the tiles. */
+    typedef PackedState<W * H> State;
+
+    /*
+     * Constructor for the ClosedSet class.
+     */
+    ClosedSet();
+
+    /**
+     * Records that a state was reached with the given number of moves.
+     * If the state has been reached before with the same number of moves
+     * or fewer, it is a duplicate and counted as pruned.
+     * @param {State} state The state that was reached.
+     * @param {int} moves_made The number of moves it took to reach it.
+     * @return {boolean} true if this is the best path to the state so far.
+     */
+    bool Insert(const State &state, int moves_made);
+
+    /**
+     * Checks if a node taken off the open list has been superseded by a
+     * shorter path to the same state, which was pushed after it.
+     * @param {State} state The state of the node.
+     * @param {int} moves_made The number of moves made to reach the node.
+     * @return {boolean} true if the node should be skipped.
+     */
+    bool IsStale(const State &state, int moves_made);
+
+    /* Forgets every state, keeping the memory for the next search unless
+       the last one used only a small part of it. */
+    void Clear();
+
+    /**
+     * Gets the number of distinct states in the set.
+     * @return {size_t} the number of states.
+     */
+    size_t GetSize() const {return this->size_;}
+
+    /**
+     * Gets the number of generated states that were dropped because they
+     * had already been reached with as few moves.
+     * @return {long} the number of duplicates pruned.
+     */
+    long GetDuplicatesPruned() const {return this->duplicates_pruned_;}
+
+    /**
+     * Gets the number of nodes skipped when taken off the open list because
+     * a shorter path to their state was found after they were pushed.
+     * @return {long} the number of stale nodes skipped.
+     */
+    long GetStaleNodesSkipped() const {return this->stale_nodes_skipped_;}
+
+ private:
+    /* A single slot in the table. A key of zero marks an empty slot, which
+       is safe since a valid board always has non-zero tiles. */
+    struct Entry {
+        State key;
+        int moves_made;
+    };
+
+    /* The number of slots allocated up front, must be a power of two. */
+    static const size_t kInitialCapacity = 1 << 16;
+
+    /* The slots of the hash table. */
+    std::vector<Entry> entries_;
+    /* Number of occupied slots. */
+    size_t size_;
+    /* Number of generated states dropped as duplicates. */
+    long duplicates_pruned_;
+    /* Number of superseded nodes skipped on the open list. */
+    long stale_nodes_skipped_;
+
+    /**
+     * Finds the slot holding a state, or the empty slot where it belongs.
+     * @param {State} state The state to look for.
+     * @return {Entry*} the slot.
+     * @private
+     */
+    Entry* Find_(const State &state);
+
+    /**
+     * Doubles the number of slots and re-inserts every state.
+     * @private
+     */
+    void Grow_();
+};
+
+#endif
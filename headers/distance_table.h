@@ -0,0 +1,116 @@
+////////////////////////////////////////////
+// Assignment 1 : Lucas Silva             //
+// The header file for the distance table //
+////////////////////////////////////////////
+
+#ifndef _distance_table_h
+#define _distance_table_h
+
+#include <stdint.h>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "board.h"
+#include "move_sequence.h"
+
+/*
+    The exact number of moves to the goal from every 8-puzzle board, one
+    byte per board, for both goal states. Only 9!/2 = 181,440 boards can
+    reach a goal, and each one is given its own index: the cell of the empty
+    space, and the Lehmer code of the order of the other eight tiles. Two
+    orders that only differ by their last two tiles have neighbouring codes
+    and opposite parity, so halving the code leaves no gaps.
+    The table is built with a breadth first search back from each goal, and
+    saved to a file, which later runs map into memory instead of building
+    it again. Solving a board is then a walk down the distances, taking
+    any move that gets one closer, with no search at all.
+    Below is a list of its private data members and their default value:
+        - {vector<uint8_t>} built_        -> initialized to empty
+        - {const uint8_t*}  distances_    -> initialized to NULL
+        - {void*}           mapping_      -> initialized to NULL
+        - {size_t}          mapping_size_ -> initialized to zero
+*/
+class DistanceTable {
+ public:
+    /* Number of boards that can reach a goal, and entries per goal. */
+    static const uint32_t kStatesPerGoal = 181440;
+    /* The distance stored for a board that cannot reach the goal. */
+    static const uint8_t kUnreached = 0xFF;
+
+    /*
+     * Constructor for the DistanceTable class.
+     */
+    DistanceTable() : distances_(NULL), mapping_(NULL), mapping_size_(0) {}
+
+    /*
+     * Destructor for the DistanceTable class. Unmaps the file, if any.
+     */
+    ~DistanceTable();
+
+    /**
+     * Maps a table saved by Save into memory.
+     * @param {string} path The file to be mapped.
+     * @return {boolean} true if the file held a valid table.
+     */
+    bool Load(const std::string &path);
+
+    /**
+     * Builds the table in memory, with a breadth first search from each
+     * goal state.
+     */
+    void Build();
+
+    /**
+     * Saves the table to a file, so it can be mapped by Load.
+     * @param {string} path The file to be written.
+     * @return {boolean} true if the whole table was written.
+     */
+    bool Save(const std::string &path) const;
+
+    /**
+     * Checks if the table was loaded or built.
+     * @return {boolean} true if lookups can be made.
+     */
+    bool IsReady() const {return this->distances_ != NULL;}
+
+    /**
+     * Gets the exact number of moves from a board to its closest goal
+     * state. Only the two standard goal states are in the table.
+     * @param {Board} board The board, must have been created.
+     * @return {int} the number of moves, or -1 if it cannot be solved or
+     *   its goal states aren't in the table.
+     */
+    int GetDistance(const Board<3, 3> &board) const;
+
+    /**
+     * Finds a shortest solution by always taking a move that is one closer
+     * to the goal.
+     * @param {Board} board The board, must have been created.
+     * @param {MoveSequence} path Filled with the moves.
+     * @return {boolean} true if the board can be solved.
+     */
+    bool FindPath(const Board<3, 3> &board, MoveSequence &path) const;
+
+ private:
+    /* The table when it was built by this run instead of loaded. */
+    std::vector<uint8_t> built_;
+    /* The distances for the top left goal, then the bottom right goal. */
+    const uint8_t* distances_;
+    /* The mapped file, NULL if the table wasn't loaded. */
+    void* mapping_;
+    /* The size of the mapped file. */
+    size_t mapping_size_;
+
+    /**
+     * Unmaps the file and forgets the table.
+     * @private
+     */
+    void Unload_();
+
+    // The table may own a mapping, so it cannot be copied.
+    DistanceTable(const DistanceTable &);
+    DistanceTable& operator=(const DistanceTable &);
+};
+
+#endif
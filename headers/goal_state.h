@@ -0,0 +1,81 @@
+////////////////////////////////////////
+// Assignment 1 : Lucas Silva         //
+// The header file for the goal state //
+////////////////////////////////////////
+
+#ifndef _goal_state_h
+#define _goal_state_h
+
+#include <vector>
+
+#include "heuristic_kernel.h"
+#include "packed_state.h"
+
+/*
+    A goal state of a W by H board, with the tables every board solved
+    towards it is scored with, filled in once when the goal is made. The
+    two standard goals, with the empty space at the top left or the bottom
+    right, are made the first time they are needed, and any other goal a
+    user gives is made when it is read.
+    Below is a list of its data members and their default value:
+        - {int}             type     -> initialized to -1
+        - {State}           state    -> initialized to empty
+        - {int[]}           cell     -> initialized to zero
+        - {signed char[][]} distance -> initialized to zero
+        - {int}             parity   -> initialized to zero
+        - {HeuristicKernel} kernel   -> initialized with no goal
+*/
+template <int W, int H>
+struct GoalState {
+    /* The packed representation of the tiles. */
+    typedef PackedState<W * H> State;
+
+    /* TOP_LEFT, BOTTOM_RIGHT, or CUSTOM_GOAL for any other goal. */
+    int type;
+    /* The tiles of the goal state. */
+    State state;
+    /* The cell each tile belongs in. */
+    int cell[W * H];
+    /* The manhattan distance of each tile from where it belongs, when it
+       is in each cell, zero for the empty space. */
+    signed char distance[W * H][W * H];
+    /* The parity of the goal state, as given by GetParity. Only boards
+       with the same parity can reach it. */
+    int parity;
+    /* Scores whole states against the goal state. */
+    HeuristicKernel<W, H> kernel;
+
+    GoalState() : type(-1), cell(), distance(), parity(0) {}
+
+    /**
+     * Fills in the goal state and its tables from its tiles.
+     * @param {vector<int>} tiles The tile in each cell, row by row.
+     * @param {int} type TOP_LEFT, BOTTOM_RIGHT or CUSTOM_GOAL.
+     * @return {boolean} false if the tiles aren't a permutation of the
+     *   W * H tiles, 0 being the empty space.
+     */
+    bool Create(const std::vector<int> &tiles, int type);
+
+    /**
+     * Gets one of the two standard goal states, made the first time it is
+     * asked for.
+     * @param {int} type TOP_LEFT or BOTTOM_RIGHT.
+     * @return {GoalState} the goal state.
+     */
+    static const GoalState& GetStandard(int type);
+
+    /**
+     * Gets the parity of a state: the number of inversions of its tiles
+     * plus, on boards of even width, the row of the empty space. For odd
+     * widths, a move never changes the parity of the number of
+     * inversions. For even widths, a vertical move flips it and also moves
+     * the empty space to another row, so the parity of their sum never
+     * changes. Explanation can be found here:
+     * http://ldc.usb.ve/~gpalma/ci2693sd08/puzzleFactible.txt
+     * @param {State} state The state.
+     * @return {int} 0 or 1.
+     */
+    static int GetParity(const State &state);
+};
+
+#endif
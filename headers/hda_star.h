@@ -0,0 +1,232 @@
+/////////////////////////////////////////
+// Assignment 1 : Lucas Silva          //
+// The header file for the HDA* search //
+/////////////////////////////////////////
+
+#ifndef _hda_star_h
+#define _hda_star_h
+
+#include <stdint.h>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <queue>
+#include <unordered_map>
+#include <vector>
+
+#include "board.h"
+#include "move_sequence.h"
+#include "packed_state.h"
+#include "search_stats.h"
+
+/*
+    Hash distributed A*, which solves a single board on many threads. Every
+    state is owned by one thread, chosen by its hash, and only that thread
+    keeps its open list entry and its fewest moves. A thread expands its
+    own boards, and sends each new board to the thread that owns it, in
+    batches over lock-free queues that many threads can push to and only
+    the owner takes from.
+    The first goal found is not always the best one, so the fewest moves
+    to a goal found so far is shared, and boards that can't beat it are
+    dropped. The search stops once no thread has a board that could beat
+    it and no batch is still on its way, so the solution is still optimal.
+    Below is a list of its private data members and their default value:
+        - {int}                 threads_     -> initialized to the given value
+        - {vector<Worker*>}     workers_     -> initialized to empty
+        - {atomic<long>}        active_      -> initialized to zero
+        - {atomic<int>}         best_moves_  -> initialized to INT_MAX
+        - {int}                 goal_thread_ -> initialized to -1
+        - {uint32_t}            goal_node_   -> initialized to zero
+        - {MoveSequence}        path_        -> initialized to empty
+        - {vector<ThreadStats>} stats_       -> initialized to empty
+*/
+template <int W, int H>
+class HdaStarSearch {
+ public:
+    /* The packed representation of the tiles. */
+    typedef PackedState<W * H> State;
+
+    /* How much work one thread did during a search. */
+    struct ThreadStats {
+        /* What the thread's own part of the search did. */
+        SearchStats search;
+        /* New boards sent to another thread. */
+        long sent;
+        /* Boards received from other threads. */
+        long received;
+        /* Boards dropped because their state was reached in as few moves. */
+        long duplicates;
+    };
+
+    /*
+     * Constructor for the HdaStarSearch class.
+     * @param {int} threads The number of threads to search on.
+     */
+    explicit HdaStarSearch(int threads);
+
+    /*
+     * Destructor for the HdaStarSearch class.
+     */
+    ~HdaStarSearch();
+
+    /**
+     * Searches for a shortest solution from the given board.
+     * @param {Board} board The initial board, must have been created.
+     * @return {boolean} true if a solution was found.
+     */
+    bool Solve(const Board<W, H> &board);
+
+    /**
+     * Gets the moves of the solution found by Solve.
+     * @return {MoveSequence} the moves, from the initial board on.
+     */
+    const MoveSequence& GetPath() const {return this->path_;}
+
+    /**
+     * Gets how much work each thread did during the last search.
+     * @return {vector<ThreadStats>} the work of each thread.
+     */
+    const std::vector<ThreadStats>& GetThreadStats() const {
+        return this->stats_;}
+
+    /**
+     * Gets what every thread did together during the last search. The peak
+     * size is the sum of the peak sizes of every thread's open list.
+     * @return {SearchStats} the statistics of the last search.
+     */
+    SearchStats GetStats() const;
+
+ private:
+    /* A state a thread owns, with the fewest moves it was reached in. */
+    struct Node {
+        State state;
+        int moves_made;
+        /* The thread and node of the previous state, -1 for the first. */
+        int parent_thread;
+        uint32_t parent;
+        /* The direction of the move from the previous state. */
+        int direction;
+    };
+
+    /* A new board, on its way to the thread that owns it. */
+    struct Message {
+        State state;
+        int moves_made;
+        int estimated_moves_remaining;
+        int parent_thread;
+        uint32_t parent;
+        int direction;
+    };
+
+    /* Messages sent together, linked into the receiving thread's inbox. */
+    struct Batch {
+        Batch* next;
+        std::vector<Message> messages;
+    };
+
+    /* An open list entry, for a node that may since have been improved. */
+    struct OpenEntry {
+        int rank;
+        int moves_made;
+        uint32_t node;
+    };
+
+    /* Orders the open list by rank, then by most moves made. */
+    struct OpenEntryCompare {
+        bool operator()(const OpenEntry &lhs, const OpenEntry &rhs) const {
+            if (lhs.rank != rhs.rank) {
+                return lhs.rank > rhs.rank;
+            }
+            return lhs.moves_made < rhs.moves_made;
+        }
+    };
+
+    /* Hashes states for the node index. */
+    struct StateHash {
+        size_t operator()(const State &state) const {
+            return static_cast<size_t>(state.Hash());
+        }
+    };
+
+    /* Everything a single thread owns. */
+    struct Worker {
+        /* Batches sent to this thread, newest first. */
+        std::atomic<Batch*> inbox;
+        /* The states this thread owns, and where they are in nodes. */
+        std::vector<Node> nodes;
+        std::unordered_map<State, uint32_t, StateHash> index;
+        /* The open list of this thread's nodes. */
+        std::priority_queue<OpenEntry, std::vector<OpenEntry>,
+                            OpenEntryCompare> open;
+        /* Messages waiting to be sent, one list for each thread. */
+        std::vector<std::vector<Message> > outgoing;
+        ThreadStats stats;
+    };
+
+    /* The number of boards a thread expands between looking for messages. */
+    static const int kExpansionsPerRound = 32;
+
+    /* The number of threads to search on. */
+    int threads_;
+    /* The state of each thread. */
+    std::vector<Worker*> workers_;
+    /* Threads that are working plus messages not yet received, the
+       search is over when this reaches zero. */
+    std::atomic<long> active_;
+    /* The fewest moves to a goal state found so far. */
+    std::atomic<int> best_moves_;
+    /* Guards the goal node below. */
+    std::mutex goal_mutex_;
+    /* The thread and node of the best goal state found so far. */
+    int goal_thread_;
+    uint32_t goal_node_;
+    /* The moves of the last solution. */
+    MoveSequence path_;
+    /* How much work each thread did in the last search. */
+    std::vector<ThreadStats> stats_;
+
+    /**
+     * Gets the thread that owns a state.
+     * @param {State} state The state.
+     * @return {int} the index of the thread.
+     * @private
+     */
+    int Owner_(const State &state) const {
+        return static_cast<int>((state.Hash() >> 32) % this->threads_);}
+
+    /**
+     * Runs one thread of the search until it is over.
+     * @param {int} thread The index of the thread.
+     * @param {Board} board The initial board.
+     * @private
+     */
+    void Work_(int thread, const Board<W, H> &board);
+
+    /**
+     * Adds a new board to the thread that owns it, unless its state was
+     * already reached in as few moves or it can't beat the best goal.
+     * @param {int} thread The index of the owning thread.
+     * @param {Message} message The new board.
+     * @private
+     */
+    void Receive_(int thread, const Message &message);
+
+    /**
+     * Sends every waiting message of a thread to the threads they are for.
+     * @param {int} thread The index of the sending thread.
+     * @private
+     */
+    void Flush_(int thread);
+
+    /**
+     * Frees the nodes, open lists and batches of the last search.
+     * @private
+     */
+    void Clear_();
+
+    // The search holds threads' state, so it cannot be copied.
+    HdaStarSearch(const HdaStarSearch &);
+    HdaStarSearch& operator=(const HdaStarSearch &);
+};
+
+#endif
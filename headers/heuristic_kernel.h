@@ -0,0 +1,133 @@
+//////////////////////////////////////////////
+// Assignment 1 : Lucas Silva               //
+// The header file for the heuristic kernel //
+//////////////////////////////////////////////
+
+#ifndef _heuristic_kernel_h
+#define _heuristic_kernel_h
+
+#include <stdint.h>
+
+#include "packed_state.h"
+
+/*
+    Scores many board states at once against one goal state: the sum of
+    the manhattan distances of their tiles, plus two moves for every tile
+    that has to leave its row or column when linear conflicts are used.
+    On boards of up to 16 cells, whose tiles are 4-bit nibbles in a single
+    word, the nibbles are spread into the bytes of a vector register laid
+    out as a 4 by 4 grid, and the goal row and column of every tile are
+    looked up all at once with byte shuffles. A row or column of the grid
+    then makes a 12-bit key, the place along the line of each tile that
+    belongs in it, and the conflicts of every possible line are in a
+    single table. With AVX2, two states are scored per pass. The best
+    implementation the processor runs is picked the first time one is
+    needed. Larger boards, and processors without SSE4.1, are scored one
+    tile at a time.
+    Below is a list of its private data members and their default value:
+        - {uint8_t[]} goal_row_    -> initialized to kNoLine
+        - {uint8_t[]} goal_column_ -> initialized to kNoLine
+*/
+template <int W, int H>
+class HeuristicKernel {
+ public:
+    /* The packed representation of the tiles. */
+    typedef PackedState<W * H> State;
+
+    /* The ways states can be scored, from slowest to fastest. */
+    enum Implementation {SCALAR, SSE4, AVX2};
+
+    /* true if the states can be scored with vector instructions. */
+    static const bool kVectorized = W <= 4 && H <= 4;
+
+    /*
+     * Constructor for the HeuristicKernel class. SetGoal must be called
+     * before any state is scored.
+     */
+    HeuristicKernel();
+
+    /**
+     * Sets the goal state the states are scored against.
+     * @param {int[]} goal_cell The cell each tile belongs in.
+     */
+    void SetGoal(const int goal_cell[W * H]);
+
+    /**
+     * Scores states with the fastest implementation available.
+     * @param {State[]} states The states to score.
+     * @param {int} count The number of states.
+     * @param {boolean} linear_conflict true to add the linear conflicts.
+     * @param {int[]} estimates Filled with the estimate of each state.
+     */
+    void Score(const State* states, int count, bool linear_conflict,
+               int* estimates) const {
+        this->ScoreWith(GetBestImplementation(), states, count,
+                        linear_conflict, estimates);
+    }
+
+    /**
+     * Scores states with the given implementation, which must be
+     * available.
+     * @param {Implementation} implementation How to score them.
+     * @param {State[]} states The states to score.
+     * @param {int} count The number of states.
+     * @param {boolean} linear_conflict true to add the linear conflicts.
+     * @param {int[]} estimates Filled with the estimate of each state.
+     */
+    void ScoreWith(Implementation implementation, const State* states,
+                   int count, bool linear_conflict, int* estimates) const;
+
+    /**
+     * Checks if an implementation can be used on this processor, for
+     * boards of this size.
+     * @param {Implementation} implementation The implementation.
+     * @return {boolean} true if it can be used.
+     */
+    static bool IsAvailable(Implementation implementation);
+
+    /**
+     * Gets the fastest implementation that can be used, checked once.
+     * @return {Implementation} the implementation.
+     */
+    static Implementation GetBestImplementation();
+
+    /**
+     * Gets the name of an implementation.
+     * @param {Implementation} implementation The implementation.
+     * @return {string} "scalar", "sse4" or "avx2".
+     */
+    static const char* GetName(Implementation implementation);
+
+ private:
+    /* Stands for a tile that belongs in no row or column of the grid,
+       which is what the empty space and the padding of the grid are. */
+    static const uint8_t kNoLine = 8;
+
+    /* The row and column each tile belongs in, 16 of each so they can be
+       loaded straight into a vector register. */
+    alignas(16) uint8_t goal_row_[W * H > 16 ? W * H : 16];
+    alignas(16) uint8_t goal_column_[W * H > 16 ? W * H : 16];
+
+    /**
+     * Scores states one tile at a time.
+     * @private
+     */
+    void ScoreScalar_(const State* states, int count, bool linear_conflict,
+                      int* estimates) const;
+
+    /**
+     * Scores states one at a time, 16 tiles per instruction.
+     * @private
+     */
+    void ScoreSse4_(const State* states, int count, bool linear_conflict,
+                    int* estimates) const;
+
+    /**
+     * Scores states two at a time, 16 tiles of each per instruction.
+     * @private
+     */
+    void ScoreAvx2_(const State* states, int count, bool linear_conflict,
+                    int* estimates) const;
+};
+
+#endif
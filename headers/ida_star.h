@@ -0,0 +1,89 @@
+/////////////////////////////////////////
+// Assignment 1 : Lucas Silva          //
+// The header file for the IDA* search //
+/////////////////////////////////////////
+
+#ifndef _ida_star_h
+#define _ida_star_h
+
+#include <vector>
+
+#include "board.h"
+#include "move_sequence.h"
+#include "search_stats.h"
+
+/*
+    Iterative deepening A* search. Instead of keeping every board it has
+    generated, it runs depth first searches on a single board, making and
+    taking back moves in place, with a bound on the rank of the boards it
+    visits. Each time the bound is too low, it is raised to the lowest rank
+    that went over it. Memory use is only the current path.
+    Below is a list of its private data members and their default value:
+        - {MoveSequence} path_       -> initialized to empty
+        - {SearchStats}  stats_      -> initialized to zero
+        - {int}          iterations_ -> initialized to zero
+*/
+template <int W, int H>
+class IdaStarSearch {
+ public:
+    /*
+     * Constructor for the IdaStarSearch class.
+     */
+    IdaStarSearch() : iterations_(0) {}
+
+    /**
+     * Searches for a shortest solution from the given board.
+     * The board is moved during the search, but is back in its initial
+     * state when this returns.
+     * @param {Board} board The initial board, must have been created.
+     * @return {boolean} true if a solution was found.
+     */
+    bool Solve(Board<W, H> &board);
+
+    /**
+     * Gets the moves of the solution found by Solve.
+     * @return {MoveSequence} the moves, from the initial board on.
+     */
+    const MoveSequence& GetPath() const {return this->path_;}
+
+    /**
+     * Gets the number of boards expanded over all iterations.
+     * @return {long} the number of boards expanded.
+     */
+    long GetNodesExpanded() const {return this->stats_.expanded;}
+
+    /**
+     * Gets what the last search did over all iterations. IDA* has no open
+     * list, so its peak size is left at zero.
+     * @return {SearchStats} the statistics of the last search.
+     */
+    const SearchStats& GetStats() const {return this->stats_;}
+
+    /**
+     * Gets the number of depth first searches that were run.
+     * @return {int} the number of iterations.
+     */
+    int GetIterations() const {return this->iterations_;}
+
+ private:
+    /* The moves on the current path. */
+    MoveSequence path_;
+    /* What the search did over all iterations. */
+    SearchStats stats_;
+    /* Number of depth first searches run. */
+    int iterations_;
+
+    /**
+     * Depth first search from the board, not going over the bound.
+     * @param {Board} board The board, moved in place.
+     * @param {int} bound The highest rank a board may have.
+     * @param {int} last_direction The direction of the last move, whose
+     *   inverse is never tried, or -1 at the initial board.
+     * @return {int} -1 if the goal was found, otherwise the lowest rank
+     *   that went over the bound.
+     * @private
+     */
+    int Search_(Board<W, H> &board, int bound, int last_direction);
+};
+
+#endif
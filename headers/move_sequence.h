@@ -0,0 +1,120 @@
+///////////////////////////////////////////
+// Assignment 1 : Lucas Silva            //
+// The header file for the move sequence //
+///////////////////////////////////////////
+
+#ifndef _move_sequence_h
+#define _move_sequence_h
+
+#include <stdint.h>
+#include <cstddef>
+#include <vector>
+
+/*
+    The moves of a solution, in order from the initial board. There are
+    only four directions (RIGHT, LEFT, UP and DOWN, numbered 1 to 4), so
+    each move takes 2 bits and a word holds 32 of them. A solution is all
+    that is needed to show every board on the way, by replaying its moves
+    from the initial board, so the searches return one instead of keeping
+    the boards they went through.
+    Below is a list of its private data members and their default value:
+        - {vector<uint64_t>} words_ -> initialized to empty
+        - {size_t}           size_  -> initialized to zero
+*/
+class MoveSequence {
+ public:
+    /*
+     * Constructor for the MoveSequence class.
+     */
+    MoveSequence() : size_(0) {}
+
+    /**
+     * Gets the number of moves.
+     * @return {size_t} the number of moves.
+     */
+    size_t size() const {return this->size_;}
+
+    /**
+     * Checks if there are no moves.
+     * @return {boolean} true if there are no moves.
+     */
+    bool empty() const {return this->size_ == 0;}
+
+    /**
+     * Gets the direction of a move.
+     * @param {size_t} i The index of the move, in the range [0, size()).
+     * @return {int} the direction of the move.
+     */
+    int operator[](size_t i) const {
+        return static_cast<int>((this->words_[i / kMovesPerWord] >>
+            ((i % kMovesPerWord) * 2)) & 3) + 1;
+    }
+
+    /**
+     * Adds a move at the end.
+     * @param {int} direction The direction of the move.
+     */
+    void push_back(int direction) {
+        if (this->size_ % kMovesPerWord == 0) {
+            this->words_.push_back(0);
+        }
+        this->words_.back() |= static_cast<uint64_t>(direction - 1) <<
+            ((this->size_ % kMovesPerWord) * 2);
+        ++this->size_;
+    }
+
+    /**
+     * Removes the last move. There must be one.
+     */
+    void pop_back() {
+        --this->size_;
+        if (this->size_ % kMovesPerWord == 0) {
+            this->words_.pop_back();
+        } else {
+            this->words_.back() &=
+                ~(3ULL << ((this->size_ % kMovesPerWord) * 2));
+        }
+    }
+
+    /* Removes every move, keeping the memory. */
+    void clear() {
+        this->words_.clear();
+        this->size_ = 0;
+    }
+
+    /**
+     * Puts the moves in the opposite order, for searches that find them
+     * from the last one back.
+     */
+    void Reverse() {
+        for (size_t i = 0, j = this->size_; i + 1 < j; ++i, --j) {
+            int first = (*this)[i];
+            this->Put_(i, (*this)[j - 1]);
+            this->Put_(j - 1, first);
+        }
+    }
+
+ private:
+    /* Number of moves stored in each word. */
+    static const size_t kMovesPerWord = 32;
+
+    /* The moves, 2 bits each, the first in the low bits of the first word. */
+    std::vector<uint64_t> words_;
+    /* The number of moves. */
+    size_t size_;
+
+    /**
+     * Overwrites the direction of a move.
+     * @param {size_t} i The index of the move.
+     * @param {int} direction The new direction.
+     * @private
+     */
+    void Put_(size_t i, int direction) {
+        int shift = static_cast<int>(i % kMovesPerWord) * 2;
+        uint64_t &word = this->words_[i / kMovesPerWord];
+        word = (word & ~(3ULL << shift)) |
+            (static_cast<uint64_t>(direction - 1) << shift);
+    }
+};
+
+#endif
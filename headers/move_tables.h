@@ -0,0 +1,96 @@
+/////////////////////////////////////////
+// Assignment 1 : Lucas Silva          //
+// The header file for the move tables //
+/////////////////////////////////////////
+
+#ifndef _move_tables_h
+#define _move_tables_h
+
+/*
+    The direction that takes back each move. The directions are numbered
+    as everywhere else, 1 to 4 for RIGHT, LEFT, UP and DOWN, and -1 stands
+    for no move, so the table is indexed by the direction plus one.
+*/
+constexpr int kInverseDirection[6] = {-1, -1, 2, 1, 4, 3};
+
+/**
+ * Gets the direction that takes back a move.
+ * @param {int} direction The direction of the move, or -1 for none.
+ * @return {int} the opposite direction, -1 if there is no move.
+ */
+inline int InverseDirection(int direction) {
+    return kInverseDirection[direction + 1];
+}
+
+/**
+ * Absolute value that can be used at compile time.
+ * @param {int} value The value.
+ * @return {int} The absolute value.
+ */
+constexpr int AbsoluteValue(int value) {
+    return value < 0 ? -value : value;
+}
+
+/*
+    Tables for moving the empty space of a W by H board, all filled in at
+    compile time, so moving a board is a few lookups instead of branches
+    on where the empty space is.
+    Goal 0 has the empty space at the top left, goal 1 at the bottom right.
+        - neighbour[cell][direction] is the cell the empty space moves to
+          from cell in the given direction, or -1 if it would leave the
+          board. Direction 0 is never a move.
+        - move_count[cell] and moves[cell] are the directions the empty
+          space can move in from cell, in the order RIGHT, LEFT, UP, DOWN.
+        - operator_count[cell][last + 1] and operators[cell][last + 1] are
+          the same, after a move in direction last, leaving out the move
+          that takes it back. last is -1 before the first move.
+        - goal_cell[goal][tile] is the cell the tile belongs in.
+    The tables a board is scored with towards a goal state, including any
+    the user gives, are kept by its GoalState.
+*/
+template <int W, int H>
+struct MoveTables {
+    int neighbour[W * H][5];
+    int move_count[W * H];
+    int moves[W * H][4];
+    int operator_count[W * H][6];
+    int operators[W * H][6][4];
+    int goal_cell[2][W * H];
+
+    constexpr MoveTables() : neighbour(), move_count(), moves(),
+        operator_count(), operators(), goal_cell() {
+        for (int cell = 0; cell < W * H; ++cell) {
+            int row = cell / W;
+            int column = cell % W;
+            this->neighbour[cell][0] = -1;
+            this->neighbour[cell][1] = (column < W - 1) ? cell + 1 : -1;
+            this->neighbour[cell][2] = (column > 0) ? cell - 1 : -1;
+            this->neighbour[cell][3] = (row > 0) ? cell - W : -1;
+            this->neighbour[cell][4] = (row < H - 1) ? cell + W : -1;
+            for (int direction = 1; direction <= 4; ++direction) {
+                if (this->neighbour[cell][direction] != -1) {
+                    this->moves[cell][this->move_count[cell]++] = direction;
+                }
+            }
+            for (int last = -1; last <= 4; ++last) {
+                int* operators = this->operators[cell][last + 1];
+                int &count = this->operator_count[cell][last + 1];
+                for (int i = 0; i < this->move_count[cell]; ++i) {
+                    if (this->moves[cell][i] != kInverseDirection[last + 1]) {
+                        operators[count++] = this->moves[cell][i];
+                    }
+                }
+            }
+        }
+        for (int tile = 0; tile < W * H; ++tile) {
+            this->goal_cell[0][tile] = tile;
+            this->goal_cell[1][tile] = (tile == 0) ? W * H - 1 : tile - 1;
+        }
+    }
+};
+
+/* The tables for every board size, built by the compiler. */
+template <int W, int H>
+constexpr MoveTables<W, H> move_tables;
+
+#endif
@@ -0,0 +1,145 @@
+////////////////////////////////////////////////
+// Assignment 1 : Lucas Silva                 //
+// The header file for the packed board state //
+////////////////////////////////////////////////
+
+#ifndef _packed_state_h
+#define _packed_state_h
+
+#include <stdint.h>
+
+/*
+    A board state with kCells cells, packed into as few 64-bit words as
+    possible. Boards of up to 16 cells (the 8- and 15-puzzle) use 4 bits
+    per tile and fit in a single word. Larger boards use 5 bits per tile,
+    12 tiles to a word. Cells are numbered row by row
+    (cell = row * width + column), and the tile in cell i lives in word
+    i / kTilesPerWord. The cell holding the empty space is cached in blank
+    so it never has to be searched for.
+    Below is a list of its data members and their default value:
+        - {uint64_t[]} words -> initialized to zero
+        - {int}        blank -> initialized to -1 (not yet filled in)
+*/
+template <int kCells>
+struct PackedState {
+    /* Number of bits used to store a single tile. */
+    static const int kBitsPerTile = (kCells <= 16) ? 4 : 5;
+    /* Number of tiles stored in each word. */
+    static const int kTilesPerWord = 64 / kBitsPerTile;
+    /* Number of words needed to store every tile. */
+    static const int kWords = (kCells + kTilesPerWord - 1) / kTilesPerWord;
+    /* Mask selecting a single tile once shifted down. */
+    static const uint64_t kTileMask = (1ULL << kBitsPerTile) - 1;
+
+    /* All the tiles, kBitsPerTile bits each. */
+    uint64_t words[kWords];
+    /* The cell holding the empty space, -1 if the state is not filled in. */
+    int blank;
+
+    PackedState() : blank(-1) {
+        for (int i = 0; i < kWords; ++i) {
+            this->words[i] = 0;
+        }
+    }
+
+    /**
+     * Gets the tile stored in a cell.
+     * @param {int} cell The cell, in the range [0, kCells).
+     * @return {int} The value of the tile.
+     */
+    int Get(int cell) const {
+        return static_cast<int>((this->words[cell / kTilesPerWord] >>
+            ((cell % kTilesPerWord) * kBitsPerTile)) & kTileMask);
+    }
+
+    /**
+     * Stores a tile in a cell, overwriting whatever was there.
+     * @param {int} cell The cell, in the range [0, kCells).
+     * @param {int} value The value of the tile.
+     */
+    void Set(int cell, int value) {
+        uint64_t &word = this->words[cell / kTilesPerWord];
+        int shift = (cell % kTilesPerWord) * kBitsPerTile;
+        word = (word & ~(kTileMask << shift)) |
+            (static_cast<uint64_t>(value) << shift);
+        if (value == 0) {
+            this->blank = cell;
+        }
+    }
+
+    /**
+     * Swaps the tiles stored in two cells. When both are in the same word,
+     * which is always the case for boards of up to 16 cells, this is a
+     * single xor mask.
+     * @param {int} cell_1 The first cell.
+     * @param {int} cell_2 The second cell.
+     */
+    void Swap(int cell_1, int cell_2) {
+        int word_1 = cell_1 / kTilesPerWord;
+        int word_2 = cell_2 / kTilesPerWord;
+        int shift_1 = (cell_1 % kTilesPerWord) * kBitsPerTile;
+        int shift_2 = (cell_2 % kTilesPerWord) * kBitsPerTile;
+        if (word_1 == word_2) {
+            uint64_t &word = this->words[word_1];
+            uint64_t diff = ((word >> shift_1) ^ (word >> shift_2)) &
+                kTileMask;
+            word ^= (diff << shift_1) | (diff << shift_2);
+            return;
+        }
+        uint64_t value_1 = (this->words[word_1] >> shift_1) & kTileMask;
+        uint64_t value_2 = (this->words[word_2] >> shift_2) & kTileMask;
+        this->words[word_1] ^= (value_1 ^ value_2) << shift_1;
+        this->words[word_2] ^= (value_1 ^ value_2) << shift_2;
+    }
+
+    /**
+     * Checks if every tile is zero, which is never the case for a valid
+     * board, so it can mark empty slots in hash tables.
+     * @return {boolean} true if every word is zero.
+     */
+    bool IsZero() const {
+        for (int i = 0; i < kWords; ++i) {
+            if (this->words[i] != 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Mixes the packed words into a well distributed hash, so that nearby
+     * states don't all land in the same part of a hash table.
+     * @return {uint64_t} The hash of the state.
+     */
+    uint64_t Hash() const {
+        uint64_t hash = 0;
+        for (int i = 0; i < kWords; ++i) {
+            hash ^= this->words[i];
+            hash ^= hash >> 33;
+            hash *= 0xff51afd7ed558ccdULL;
+            hash ^= hash >> 33;
+            hash *= 0xc4ceb9fe1a85ec53ULL;
+            hash ^= hash >> 33;
+        }
+        return hash;
+    }
+};
+
+template <int kCells>
+inline bool operator==(const PackedState<kCells> &lhs,
+                       const PackedState<kCells> &rhs) {
+    for (int i = 0; i < PackedState<kCells>::kWords; ++i) {
+        if (lhs.words[i] != rhs.words[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <int kCells>
+inline bool operator!=(const PackedState<kCells> &lhs,
+                       const PackedState<kCells> &rhs) {
+    return !(lhs == rhs);
+}
+
+#endif
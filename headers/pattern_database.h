@@ -0,0 +1,107 @@
+//////////////////////////////////////////////
+// Assignment 1 : Lucas Silva               //
+// The header file for the pattern database //
+//////////////////////////////////////////////
+
+#ifndef _pattern_database_h
+#define _pattern_database_h
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "packed_state.h"
+
+/*
+    An additive disjoint pattern database for boards of W by H tiles. The
+    tiles are split into groups of kGroupSize consecutive tiles, and for
+    each group and goal state a table holds the fewest moves of that
+    group's own tiles needed to bring them home, whatever the other tiles
+    do. Since every move is counted in at most one group, the sum over the
+    groups never overestimates, and it is never below the sum of the
+    manhattan distances.
+    A table is indexed by the cells of the group's tiles, ranked as a
+    partial permutation of the cells, and is filled by a breadth first
+    search back from the goal, where moving the empty space through a tile
+    of another group is free. Building takes a while for the larger
+    boards, so it is done once and saved to a file for Load.
+    Below is a list of its private data members and their default value:
+        - {vector<uint8_t>} tables_ -> initialized to empty
+*/
+template <int W, int H>
+class PatternDatabase {
+ public:
+    /* Number of cells on the board. */
+    static const int kCells = W * H;
+    /* Number of tiles in a group, chosen to keep each table small. */
+    static const int kGroupSize = (kCells == 16) ? 5 : 4;
+    /* Number of groups, which together hold every tile. */
+    static const int kGroups = (kCells - 1) / kGroupSize;
+    /* Number of ways to place the tiles of a group on the board. */
+    static const uint32_t kEntriesPerTable =
+        (kGroupSize == 5) ? kCells * (kCells - 1) * (kCells - 2) *
+                            (kCells - 3) * (kCells - 4)
+                          : kCells * (kCells - 1) * (kCells - 2) *
+                            (kCells - 3);
+
+    /* The packed representation of the tiles. */
+    typedef PackedState<W * H> State;
+
+    /**
+     * Builds the tables for every group and both goal states.
+     */
+    void Build();
+
+    /**
+     * Loads the tables saved by Save.
+     * @param {string} path The file to be read.
+     * @return {boolean} true if the file held valid tables for this size.
+     */
+    bool Load(const std::string &path);
+
+    /**
+     * Saves the tables to a file, so they can be read by Load.
+     * @param {string} path The file to be written.
+     * @return {boolean} true if every table was written.
+     */
+    bool Save(const std::string &path) const;
+
+    /**
+     * Gets the group a tile belongs to.
+     * @param {int} tile The tile, not the empty space.
+     * @return {int} the group of the tile.
+     */
+    static int GetGroup(int tile) {return (tile - 1) / kGroupSize;}
+
+    /**
+     * Gets the estimated moves remaining for the tiles of one group.
+     * @param {State} state The board state.
+     * @param {int} goal_state_type TOP_LEFT or BOTTOM_RIGHT.
+     * @param {int} group The group.
+     * @return {int} the moves the group needs at the least.
+     */
+    int GetGroupEstimate(const State &state, int goal_state_type,
+                         int group) const;
+
+    /**
+     * Gets the estimated moves remaining, the sum over every group.
+     * @param {State} state The board state.
+     * @param {int} goal_state_type TOP_LEFT or BOTTOM_RIGHT.
+     * @return {int} the estimated moves remaining.
+     */
+    int GetEstimate(const State &state, int goal_state_type) const;
+
+ private:
+    /* The tables, for each goal state and then each group. */
+    std::vector<uint8_t> tables_;
+
+    /**
+     * Fills the table of one group and goal state.
+     * @param {int} goal The goal index, 0 for TOP_LEFT, 1 for BOTTOM_RIGHT.
+     * @param {int} group The group.
+     * @private
+     */
+    void BuildTable_(int goal, int group);
+};
+
+#endif
@@ -0,0 +1,121 @@
+//////////////////////////////////////////////////
+// Assignment 1 : Lucas Silva                   //
+// The header file for the performance counters //
+//////////////////////////////////////////////////
+
+#ifndef _perf_counters_h
+#define _perf_counters_h
+
+#include <stdint.h>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/*
+    Hardware performance counters, read with perf_event_open on Linux:
+    cycles, instructions, L1 data cache misses, last level cache misses
+    and branch misses. They count the thread that opened them and every
+    thread it starts afterwards, in user space only.
+    The work is split into phases, and Start and Stop add what happened in
+    between to the counts of a phase, so a phase can be counted more than
+    once. A counter the kernel or the machine doesn't support, which is
+    every counter outside Linux, is left out rather than read as zero.
+    Below is a list of its private data members and their default value:
+        - {vector<string>}  phase_names_ -> initialized to the given value
+        - {int[]}           files_       -> initialized to the opened ones
+        - {vector<Reading>} readings_    -> initialized to zero
+        - {int}             phase_       -> initialized to -1
+        - {uint64_t[][3]}   start_       -> initialized to zero
+        - {time_point}      start_time_  -> initialized to zero
+*/
+class PerfCounters {
+ public:
+    /* The number of counters. */
+    static const int kEvents = 5;
+
+    /* The name of each counter, as written in reports. */
+    static const char* const kEventNames[kEvents];
+
+    /* What was counted during a phase. */
+    struct Reading {
+        /* The count of each counter, -1 if it isn't available. */
+        long long counts[kEvents];
+        /* The wall time of the phase, in milliseconds. */
+        double wall_ms;
+    };
+
+    /*
+     * Constructor for the PerfCounters class, which opens the counters.
+     * @param {vector<string>} phase_names The name of each phase.
+     */
+    explicit PerfCounters(const std::vector<std::string> &phase_names);
+
+    /*
+     * Destructor for the PerfCounters class, which closes the counters.
+     */
+    ~PerfCounters();
+
+    /**
+     * Checks if any of the counters could be opened.
+     * @return {boolean} true if at least one counter is available.
+     */
+    bool IsAvailable() const;
+
+    /**
+     * Starts counting a phase, stopping the phase before it if there is
+     * one.
+     * @param {int} phase The index of the phase.
+     */
+    void Start(int phase);
+
+    /**
+     * Stops counting, and adds what was counted to the current phase.
+     */
+    void Stop();
+
+    /**
+     * Gets what was counted during a phase.
+     * @param {int} phase The index of the phase.
+     * @return {Reading} the counts of the phase.
+     */
+    const Reading& GetReading(int phase) const {
+        return this->readings_[phase];}
+
+    /**
+     * Writes the counts of every phase as a table, with "n/a" for the
+     * counters that aren't available.
+     * @param {ostream} out The stream to write to.
+     */
+    void Write(std::ostream &out) const;
+
+ private:
+    /* The name of each phase. */
+    std::vector<std::string> phase_names_;
+    /* The file of each counter, -1 if it could not be opened. */
+    int files_[kEvents];
+    /* What was counted during each phase. */
+    std::vector<Reading> readings_;
+    /* The phase being counted, -1 if none is. */
+    int phase_;
+    /* The value, time enabled and time running of each counter when the
+       phase started. */
+    uint64_t start_[kEvents][3];
+    /* When the phase started. */
+    std::chrono::steady_clock::time_point start_time_;
+
+    /**
+     * Reads the value, time enabled and time running of a counter.
+     * @param {int} event The index of the counter.
+     * @param {uint64_t[3]} values Filled with what was read.
+     * @return {boolean} true if the counter could be read.
+     * @private
+     */
+    bool Read_(int event, uint64_t values[3]) const;
+
+    // The counters are open files, so they cannot be copied.
+    PerfCounters(const PerfCounters &);
+    PerfCounters& operator=(const PerfCounters &);
+};
+
+#endif
@@ -0,0 +1,115 @@
+///////////////////////////////////////////
+// Assignment 1 : Lucas Silva            //
+// The header file for the puzzle server //
+///////////////////////////////////////////
+
+#ifndef _puzzle_server_h
+#define _puzzle_server_h
+
+#include <iostream>
+#include <string>
+
+#include "distance_table.h"
+#include "solution_cache.h"
+#include "solver.h"
+
+/*
+    Keeps solving boards for as long as they come, one per line, and
+    answers each one with a single line, as Solver::WriteResult writes it.
+    Blank lines get no answer, and a line with only "stats" is answered
+    with the counters of the cache as JSON. Boards come either from a
+    stream, answered in order by a single Solver, or from the connections
+    to a Unix domain socket, served by a pool of workers at once. Each
+    worker has its own Solver for as long as the server runs, so the
+    tables and pattern databases are loaded once, and the searches keep
+    their memory from one board to the next, whichever connection it came
+    from. The workers can share a cache of solutions.
+    The heuristic is whatever was set on the Board classes beforehand.
+    Below is a list of its private data members and their default value:
+        - {SolveOptions}   options_ -> initialized to the given value
+        - {int}            threads_ -> initialized to the given value
+        - {DistanceTable}  table_   -> initialized to the given table
+        - {SolutionCache*} cache_   -> initialized to the given value
+*/
+class PuzzleServer {
+ public:
+    /*
+     * Constructor for the PuzzleServer class.
+     * @param {SolveOptions} options How to solve every board.
+     * @param {int} threads The number of workers serving the socket.
+     * @param {DistanceTable} table The distance table, used by TABLE_WALK.
+     * @param {SolutionCache*} cache The cache of solutions, NULL if there
+     *   is none.
+     */
+    PuzzleServer(const SolveOptions &options, int threads,
+                 const DistanceTable &table, SolutionCache* cache) :
+        options_(options), threads_(threads), table_(table), cache_(cache) {}
+
+    /**
+     * Answers every board read from a stream, until it ends. Each answer
+     * is flushed as soon as it is written.
+     * @param {istream} in The stream to read the boards from.
+     * @param {ostream} out The stream to write the answers to.
+     * @return {int} the number of boards solved.
+     */
+    int ServeStream(std::istream &in, std::ostream &out);
+
+    /**
+     * Listens on a Unix domain socket, replacing the socket a stopped
+     * server left at its path, and answers the boards sent on every
+     * connection to it. A file, or the socket of a server that is still
+     * listening, is left alone and the socket isn't opened. Only returns
+     * if the socket can't be opened, or stops accepting.
+     * @param {string} path The path of the socket.
+     * @return {boolean} false if the socket couldn't be opened.
+     */
+    bool ServeSocket(const std::string &path);
+
+ private:
+    /* How every board is solved. */
+    SolveOptions options_;
+    /* The number of workers serving the socket. */
+    int threads_;
+    /* The distance table, used by TABLE_WALK. */
+    const DistanceTable &table_;
+    /* The cache of solutions shared by the workers. */
+    SolutionCache* cache_;
+
+    /**
+     * Accepts connections to the socket and serves them one at a time,
+     * until accepting fails.
+     * @param {int} listener The listening socket.
+     * @private
+     */
+    void Work_(int listener);
+
+    /**
+     * Answers a single line.
+     * @param {string} line The line, a board or "stats".
+     * @param {Solver} solver The solver to solve the board with.
+     * @param {SolveResult} result Filled with what was found.
+     * @param {ostream} out The stream to write the answer to, without the
+     *   end of line.
+     * @return {boolean} true if a board was solved.
+     * @private
+     */
+    bool Answer_(const std::string &line, Solver &solver, SolveResult &result,
+                 std::ostream &out);
+
+    /**
+     * Answers the boards sent on a connection, until it is closed.
+     * @param {int} connection The connected socket.
+     * @param {Solver} solver The worker's solver.
+     * @param {string} pending A buffer for the part of a line not yet
+     *   answered, kept by the worker.
+     * @private
+     */
+    void ServeConnection_(int connection, Solver &solver,
+                          std::string &pending);
+
+    // The server refers to a table it doesn't own, so it cannot be copied.
+    PuzzleServer(const PuzzleServer &);
+    PuzzleServer& operator=(const PuzzleServer &);
+};
+
+#endif
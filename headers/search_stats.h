@@ -0,0 +1,148 @@
+///////////////////////////////////////////////
+// Assignment 1 : Lucas Silva                //
+// The header file for the search statistics //
+///////////////////////////////////////////////
+
+#ifndef _search_stats_h
+#define _search_stats_h
+
+#include <cstddef>
+#include <iostream>
+#include <vector>
+
+/*
+    What a search did, counted as it goes. The boards expanded, expanded
+    again and generated and the peak size of the open list are always
+    counted, since they are cheap and the searches report them. Compile
+    with SEARCH_STATS defined to also count the children dropped for going
+    straight back to their parent or for reaching a state in no fewer
+    moves than before, and to keep a histogram of the rank and of the
+    moves made of every board expanded. Without it, those counters don't
+    exist and counting them does nothing.
+    Below is a list of its data members and their default value:
+        - {long}         expanded        -> initialized to zero
+        - {long}         reexpanded      -> initialized to zero
+        - {long}         generated       -> initialized to zero
+        - {size_t}       peak_open       -> initialized to zero
+        - {long}         parent_prunes   -> initialized to zero
+        - {long}         duplicates      -> initialized to zero
+        - {vector<long>} rank_histogram  -> initialized to empty
+        - {vector<long>} depth_histogram -> initialized to empty
+*/
+struct SearchStats {
+    /* Boards taken off the open list and expanded. */
+    long expanded;
+    /* Boards put back on the open list by partial expansion and taken off
+       it again, which aren't counted as expanded a second time. */
+    long reexpanded;
+    /* Boards made by moving the expanded boards. */
+    long generated;
+    /* The most boards the open list held at once. */
+    size_t peak_open;
+#ifdef SEARCH_STATS
+    /* Children dropped because they undo the move that made the parent. */
+    long parent_prunes;
+    /* Children dropped because their state was reached in as few moves. */
+    long duplicates;
+    /* The number of boards expanded with each rank and moves made. */
+    std::vector<long> rank_histogram;
+    std::vector<long> depth_histogram;
+#endif
+
+    SearchStats() : expanded(0), reexpanded(0), generated(0), peak_open(0)
+#ifdef SEARCH_STATS
+        , parent_prunes(0), duplicates(0)
+#endif
+        {}
+
+    /**
+     * Counts a board being expanded.
+     * @param {int} rank The rank of the board.
+     * @param {int} moves_made The moves made to reach the board.
+     */
+    void CountExpansion(int rank, int moves_made) {
+        ++this->expanded;
+#ifdef SEARCH_STATS
+        AddToHistogram_(this->rank_histogram, rank);
+        AddToHistogram_(this->depth_histogram, moves_made);
+#else
+        (void) rank;
+        (void) moves_made;
+#endif
+    }
+
+    /**
+     * Counts a board put back by partial expansion being expanded again.
+     */
+    void CountReexpansion() {++this->reexpanded;}
+
+    /**
+     * Counts a new board made by moving an expanded board.
+     */
+    void CountGeneration() {++this->generated;}
+
+    /**
+     * Counts a child dropped for undoing the move that made its parent.
+     */
+    void CountParentPrune() {
+#ifdef SEARCH_STATS
+        ++this->parent_prunes;
+#endif
+    }
+
+    /**
+     * Counts a child dropped for reaching a state in no fewer moves than
+     * before.
+     */
+    void CountDuplicate() {
+#ifdef SEARCH_STATS
+        ++this->duplicates;
+#endif
+    }
+
+    /**
+     * Raises the peak size of the open list if it has grown past it.
+     * @param {size_t} open_size The size of the open list now.
+     */
+    void UpdatePeakOpen(size_t open_size) {
+        if (open_size > this->peak_open) {
+            this->peak_open = open_size;
+        }
+    }
+
+    /**
+     * Adds the counts of another search, as when threads search together.
+     * The peak sizes of the open lists are added too, since each had its
+     * own.
+     * @param {SearchStats} other The counts to add.
+     */
+    void Add(const SearchStats &other);
+
+    /**
+     * Writes every count as a single JSON object. The histograms map each
+     * rank or number of moves made to how many boards were expanded with
+     * it, and are left out along with the other counters that only exist
+     * with SEARCH_STATS defined.
+     * @param {ostream} out The stream to write to.
+     */
+    void WriteJson(std::ostream &out) const;
+
+ private:
+    /**
+     * Counts a value in a histogram, growing it as needed.
+     * @param {vector<long>} histogram The histogram, indexed by value.
+     * @param {int} value The value.
+     * @private
+     */
+    static void AddToHistogram_(std::vector<long> &histogram, int value) {
+        if (value < 0) {
+            return;
+        }
+        if (static_cast<size_t>(value) >= histogram.size()) {
+            histogram.resize(value + 1, 0);
+        }
+        ++histogram[value];
+    }
+};
+
+#endif
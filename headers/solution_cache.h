@@ -0,0 +1,210 @@
+////////////////////////////////////////////
+// Assignment 1 : Lucas Silva             //
+// The header file for the solution cache //
+////////////////////////////////////////////
+
+#ifndef _solution_cache_h
+#define _solution_cache_h
+
+#include <stdint.h>
+#include <cstddef>
+#include <iostream>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "move_sequence.h"
+#include "packed_state.h"
+
+/*
+    What a SolutionCache did, added up over every shard.
+    Below is a list of its data members and their default value:
+        - {long}   hits       -> initialized to zero
+        - {long}   misses     -> initialized to zero
+        - {long}   insertions -> initialized to zero
+        - {long}   evictions  -> initialized to zero
+        - {size_t} size       -> initialized to zero
+        - {size_t} capacity   -> initialized to zero
+*/
+struct CacheStats {
+    /* Lookups that found a solution. */
+    long hits;
+    /* Lookups that didn't. */
+    long misses;
+    /* Solutions added for states that weren't in the cache. */
+    long insertions;
+    /* Solutions dropped to make room for new ones. */
+    long evictions;
+    /* The number of states in the cache. */
+    size_t size;
+    /* The most states the cache holds. */
+    size_t capacity;
+
+    CacheStats() : hits(0), misses(0), insertions(0), evictions(0), size(0),
+        capacity(0) {}
+
+    /**
+     * Writes the counters as a single JSON object, without the end of
+     * line.
+     * @param {ostream} out The stream to write to.
+     */
+    void WriteJson(std::ostream &out) const;
+};
+
+/*
+    A bounded cache of shortest solutions, shared by every thread, keyed on
+    the packed state of a board and its goal. Boards of every size share
+    the one cache. Every part of a shortest solution that ends at the goal
+    is itself a shortest solution, so once a board is solved, each state on
+    its solution can be stored with the moves left from it, and a board
+    sent again a few moves further along is answered without a search.
+    The states are spread over shards by hash, each with its own lock, so
+    threads rarely wait on each other. When a shard is full, the CLOCK
+    algorithm picks what to evict: a lookup only marks its state as used,
+    and the hand sweeping the shard clears those marks, evicting the first
+    state that wasn't used since the hand last went by.
+    Below is a list of its private data members and their default value:
+        - {size_t}  shard_capacity_ -> initialized from the given capacity
+        - {Shard[]} shards_         -> initialized to empty
+*/
+class SolutionCache {
+ public:
+    /*
+     * Constructor for the SolutionCache class.
+     * @param {size_t} capacity The most states the cache holds, at least
+     *   one for each shard.
+     */
+    explicit SolutionCache(size_t capacity);
+
+    /**
+     * Looks up the shortest solution from a state.
+     * @param {PackedState} state The state of the board.
+     * @param {uint64_t} goal An id of the goal state, like the goal state
+     *   type of the board.
+     * @param {MoveSequence} moves Set to the moves of the solution, if the
+     *   state is in the cache.
+     * @return {boolean} true if the state is in the cache.
+     */
+    template <int kCells>
+    bool Lookup(const PackedState<kCells> &state, uint64_t goal,
+                MoveSequence &moves) {
+        return this->Lookup_(MakeKey_(state, goal), moves);}
+
+    /**
+     * Stores the shortest solution from a state, evicting another state if
+     * its shard is full.
+     * @param {PackedState} state The state of the board.
+     * @param {uint64_t} goal An id of the goal state, like the goal state
+     *   type of the board.
+     * @param {MoveSequence} moves The moves of the solution.
+     */
+    template <int kCells>
+    void Insert(const PackedState<kCells> &state, uint64_t goal,
+                const MoveSequence &moves) {
+        this->Insert_(MakeKey_(state, goal), moves);}
+
+    /**
+     * Gets the counters of every shard, added up.
+     * @return {CacheStats} the counters.
+     */
+    CacheStats GetStats() const;
+
+ private:
+    /* The number of shards, each with its own lock. */
+    static const int kShards = 16;
+    /* The most words of any supported board, the 24-puzzle's. */
+    static const int kMaxWords = PackedState<25>::kWords;
+
+    /* A state and its goal, the same for boards of any size. */
+    struct Key {
+        uint64_t words[kMaxWords];
+        uint64_t goal;
+        int cells;
+
+        bool operator==(const Key &other) const;
+    };
+
+    /* Hashes keys for the index of a shard. */
+    struct KeyHash {
+        size_t operator()(const Key &key) const {
+            return static_cast<size_t>(HashKey_(key));
+        }
+    };
+
+    /* A state in the cache, with its solution. */
+    struct Slot {
+        Key key;
+        MoveSequence moves;
+        /* true if it was looked up since the hand last went by. */
+        bool referenced;
+    };
+
+    /* A part of the cache, and the lock that guards it. */
+    struct Shard {
+        mutable std::mutex mutex;
+        std::unordered_map<Key, size_t, KeyHash> index;
+        std::vector<Slot> slots;
+        size_t hand;
+        long hits;
+        long misses;
+        long insertions;
+        long evictions;
+
+        Shard() : hand(0), hits(0), misses(0), insertions(0), evictions(0) {}
+    };
+
+    /* The most states each shard holds. */
+    size_t shard_capacity_;
+    /* The shards, picked by the hash of a key. */
+    Shard shards_[kShards];
+
+    /**
+     * Makes the key of a state and its goal.
+     * @param {PackedState} state The state.
+     * @param {uint64_t} goal The id of the goal state.
+     * @return {Key} the key.
+     * @private
+     */
+    template <int kCells>
+    static Key MakeKey_(const PackedState<kCells> &state, uint64_t goal) {
+        Key key;
+        for (int i = 0; i < kMaxWords; ++i) {
+            key.words[i] = i < PackedState<kCells>::kWords ?
+                state.words[i] : 0;
+        }
+        key.goal = goal;
+        key.cells = kCells;
+        return key;
+    }
+
+    /**
+     * Mixes the words of a key into a well distributed hash.
+     * @param {Key} key The key.
+     * @return {uint64_t} the hash of the key.
+     * @private
+     */
+    static uint64_t HashKey_(const Key &key);
+
+    /**
+     * Looks up the solution stored for a key.
+     * @param {Key} key The key.
+     * @param {MoveSequence} moves Set to the moves, if the key is there.
+     * @return {boolean} true if the key is in the cache.
+     * @private
+     */
+    bool Lookup_(const Key &key, MoveSequence &moves);
+
+    /**
+     * Stores the solution for a key.
+     * @param {Key} key The key.
+     * @param {MoveSequence} moves The moves of the solution.
+     * @private
+     */
+    void Insert_(const Key &key, const MoveSequence &moves);
+
+    // The cache holds locks, so it cannot be copied.
+    SolutionCache(const SolutionCache &);
+    SolutionCache& operator=(const SolutionCache &);
+};
+
+#endif
@@ -0,0 +1,201 @@
+////////////////////////////////////
+// Assignment 1 : Lucas Silva     //
+// The header file for the solver //
+////////////////////////////////////
+
+#ifndef _solver_h
+#define _solver_h
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "a_star_search.h"
+#include "anytime_search.h"
+#include "bidirectional_search.h"
+#include "distance_table.h"
+#include "ida_star.h"
+#include "move_sequence.h"
+#include "solution_cache.h"
+
+/* The ways a board can be solved. */
+enum SearchKind {
+    HEAP_SEARCH = 1,              // A* with a binary heap as the open list
+    BUCKET_SEARCH = 2,            // A* with a bucket queue as the open list
+    IDA_STAR_SEARCH = 3,          // Iterative deepening A*
+    TABLE_WALK = 4,               // Walk down the 8-puzzle distance table
+    HDA_STAR_SEARCH = 5,          // Hash distributed A* on many threads
+    BIDIRECTIONAL_SEARCH = 6,     // Search from both ends until they meet
+    WEIGHTED_SEARCH = 7,          // Weighted or anytime A*, within a budget
+    PARTIAL_EXPANSION_SEARCH = 8  // A* that only makes children of equal rank
+};
+
+/*
+    How the Solver solves a board.
+    Below is a list of its data members and their default value:
+        - {SearchKind}      search  -> initialized to HEAP_SEARCH
+        - {AnytimeSettings} anytime -> initialized to its defaults
+*/
+struct SolveOptions {
+    /* HEAP_SEARCH, BUCKET_SEARCH, IDA_STAR_SEARCH, TABLE_WALK,
+       BIDIRECTIONAL_SEARCH, WEIGHTED_SEARCH or PARTIAL_EXPANSION_SEARCH.
+       HDA_STAR_SEARCH is solved with HEAP_SEARCH, since it would want
+       every thread to itself. */
+    SearchKind search;
+    /* The weight and the budget, used by WEIGHTED_SEARCH. */
+    AnytimeSettings anytime;
+
+    SolveOptions() : search(HEAP_SEARCH) {}
+};
+
+/*
+    What the Solver found for a board. It can be passed to Solve again
+    and again, and keeps the memory of its moves.
+    Below is a list of its data members and their default value:
+        - {boolean}      solved   -> initialized to false
+        - {const char*}  error    -> initialized to NULL
+        - {MoveSequence} moves    -> initialized to empty
+        - {double}       bound    -> initialized to zero
+        - {long}         expanded -> initialized to zero
+        - {boolean}      cached   -> initialized to false
+*/
+struct SolveResult {
+    /* true if the board was solved, or was already at its goal state. */
+    bool solved;
+    /* Why the board wasn't solved, NULL if it was. */
+    const char* error;
+    /* The moves of the solution. */
+    MoveSequence moves;
+    /* The solution is at most this times longer than the shortest one, 1
+       for every search but WEIGHTED_SEARCH. */
+    double bound;
+    /* The number of boards the search expanded. */
+    long expanded;
+    /* true if the solution came from the cache, without a search. */
+    bool cached;
+
+    SolveResult() : solved(false), error(NULL), bound(0), expanded(0),
+        cached(false) {}
+};
+
+/*
+    Solves boards of any of the supported sizes, one after another, for
+    callers that have many boards to solve, like the batch solver and the
+    server. Each search it uses is made the first time it is needed, and
+    then kept with its closed set, open list and nodes, so once those have
+    grown to fit the boards, solving another board doesn't allocate them
+    again. With a SolutionCache, it is checked before any search, and every
+    state on a shortest solution found is stored in it with the moves left
+    from there. A Solver is not safe to use from more than one thread, so
+    each thread keeps its own, while they can all share one cache.
+    The heuristic is whatever was set on the Board classes beforehand.
+    Below is a list of its private data members and their default value:
+        - {DistanceTable*}  table_        -> initialized to the given value
+        - {SolutionCache*}  cache_        -> initialized to the given value
+        - {Searches<3, 3>*} searches_3x3_ -> initialized to NULL
+        - {Searches<4, 4>*} searches_4x4_ -> initialized to NULL
+        - {Searches<5, 5>*} searches_5x5_ -> initialized to NULL
+        - {vector<int>}     tiles_        -> initialized to empty
+        - {MoveSequence}    suffix_       -> initialized to empty
+*/
+class Solver {
+ public:
+    /*
+     * Constructor for the Solver class.
+     * @param {DistanceTable*} table The distance table, used by TABLE_WALK,
+     *   NULL if there is none.
+     * @param {SolutionCache*} cache The cache of solutions, NULL if there is
+     *   none.
+     */
+    Solver(const DistanceTable* table, SolutionCache* cache) : table_(table),
+        cache_(cache), searches_3x3_(NULL), searches_4x4_(NULL),
+        searches_5x5_(NULL) {}
+
+    /*
+     * Destructor for the Solver class, which frees the searches.
+     */
+    ~Solver();
+
+    /**
+     * Solves a board. The size of the board is decided by the number of
+     * tiles, like the solver does. A search that runs out of memory fails
+     * with "out of memory" and leaves the solver ready for the next board.
+     * @param {string} input The tiles of the board.
+     * @param {SolveOptions} options How to solve it.
+     * @param {SolveResult} result Filled with what was found.
+     * @return {boolean} true if the board was solved.
+     */
+    bool Solve(const std::string &input, const SolveOptions &options,
+               SolveResult &result);
+
+    /**
+     * Writes a result on a single line, without the end of line: the
+     * number of moves and the direction of each move (R, L, U or D for
+     * where the empty space went), then the bound if the solution may not
+     * be a shortest one, or else why the board wasn't solved.
+     * @param {SolveResult} result The result.
+     * @param {ostream} out The stream to write to.
+     */
+    static void WriteResult(const SolveResult &result, std::ostream &out);
+
+ private:
+    /* Every search the solver uses on boards of one size. */
+    template <int W, int H>
+    struct Searches {
+        AStarSearch<W, H> a_star_heap;
+        AStarSearch<W, H> a_star_buckets;
+        AStarSearch<W, H> a_star_partial;
+        IdaStarSearch<W, H> ida_star;
+        BidirectionalSearch<W, H> bidirectional;
+        AnytimeSearch<W, H> anytime;
+        /* The problem context of the board being solved, reused by every
+           request rather than made for each of them. */
+        ProblemContext<W, H> problem;
+
+        Searches() : a_star_heap(false), a_star_buckets(true),
+            a_star_partial(true, true),
+            anytime(AnytimeSettings()), problem("") {}
+    };
+
+    /* The distance table, used by TABLE_WALK. */
+    const DistanceTable* table_;
+    /* The cache of solutions, shared with other solvers. */
+    SolutionCache* cache_;
+    /* The searches for each board size, made when first needed. */
+    Searches<3, 3>* searches_3x3_;
+    Searches<4, 4>* searches_4x4_;
+    Searches<5, 5>* searches_5x5_;
+    /* The tiles of the last input, to tell its size. */
+    std::vector<int> tiles_;
+    /* The moves left from each state of a solution being cached. */
+    MoveSequence suffix_;
+
+    /**
+     * Solves a board of a given size.
+     * @param {string} input The tiles of the board.
+     * @param {SolveOptions} options How to solve it.
+     * @param {Searches*} searches The searches for the size, made if NULL.
+     * @param {SolveResult} result Filled with what was found.
+     * @return {boolean} true if the board was solved.
+     * @private
+     */
+    template <int W, int H>
+    bool Solve_(const std::string &input, const SolveOptions &options,
+                Searches<W, H>* &searches, SolveResult &result);
+
+    /**
+     * Stores every state on a shortest solution in the cache, with the
+     * moves left from it.
+     * @param {Board} board The initial board.
+     * @param {MoveSequence} moves The moves of the solution.
+     * @private
+     */
+    template <int W, int H>
+    void CacheSolution_(const Board<W, H> &board, const MoveSequence &moves);
+
+    // The solver owns its searches, so it cannot be copied.
+    Solver(const Solver &);
+    Solver& operator=(const Solver &);
+};
+
+#endif
@@ -0,0 +1,506 @@
+//////////////////////////////////////////////////////
+// Assignment 1 : Lucas Silva                       //
+// The implementation file for the heuristic kernel //
+//////////////////////////////////////////////////////
+
+#include <stdint.h>
+#include <cassert>
+#include <cstdlib>
+
+#include "headers/heuristic_kernel.h"
+
+// The vector implementations are built for x86 with GCC or Clang, which
+// can compile them for SSE4.1 and AVX2 without the rest of the program
+// needing those instructions.
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define HEURISTIC_KERNEL_X86
+#include <immintrin.h>
+#endif
+
+namespace {
+
+/* A tile's place along a line of the grid, when it doesn't belong in it. */
+const int kNotInLine = 4;
+
+/*
+ * The linear conflicts of every line of up to 4 tiles, filled in at
+ * compile time. The key of a line has 3 bits for each of its cells, the
+ * place along the line where the tile in it belongs, or kNotInLine. The
+ * tiles that may stay are the longest run already in order, and every
+ * other tile that belongs in the line has to leave it.
+ */
+struct ConflictTable {
+    unsigned char conflicts[1 << 12];
+
+    constexpr ConflictTable() : conflicts() {
+        for (int key = 0; key < (1 << 12); ++key) {
+            int targets[4] = {0, 0, 0, 0};
+            int count = 0;
+            for (int i = 0; i < 4; ++i) {
+                int place = (key >> (3 * i)) & 7;
+                if (place < kNotInLine) {
+                    targets[count++] = place;
+                }
+            }
+            int longest[4] = {0, 0, 0, 0};
+            int longest_in_order = 0;
+            for (int i = 0; i < count; ++i) {
+                longest[i] = 1;
+                for (int j = 0; j < i; ++j) {
+                    if (targets[j] < targets[i] &&
+                        longest[j] + 1 > longest[i]) {
+                        longest[i] = longest[j] + 1;
+                    }
+                }
+                if (longest[i] > longest_in_order) {
+                    longest_in_order = longest[i];
+                }
+            }
+            this->conflicts[key] =
+                static_cast<unsigned char>(count - longest_in_order);
+        }
+    }
+};
+
+constexpr ConflictTable conflict_table;
+
+/*
+ * Where each cell of a W by H board goes in the 4 by 4 grid of a vector
+ * register, filled in at compile time. grid[lane] is the cell shown in
+ * lane row * 4 + column of the grid, or 0x80, which a byte shuffle turns
+ * into a zero, the empty space, where the board has no such cell.
+ */
+template <int W, int H>
+struct GridLayout {
+    signed char grid[16];
+
+    constexpr GridLayout() : grid() {
+        for (int lane = 0; lane < 16; ++lane) {
+            int row = lane / 4;
+            int column = lane % 4;
+            this->grid[lane] = (row < H && column < W) ?
+                static_cast<signed char>(row * W + column) :
+                static_cast<signed char>(0x80);
+        }
+    }
+};
+
+template <int W, int H>
+constexpr GridLayout<W, H> grid_layout;
+
+/**
+ * Counts the linear conflicts in a line of any length, from the places
+ * along it where its tiles belong, in the order they are in now.
+ * @param {int[]} targets The places, of the tiles that belong in the line.
+ * @param {int} count The number of those tiles.
+ * @return {int} the number of tiles that must leave the line.
+ */
+int CountConflicts(const int* targets, int count) {
+    int longest[16];
+    int longest_in_order = 0;
+    for (int i = 0; i < count; ++i) {
+        longest[i] = 1;
+        for (int j = 0; j < i; ++j) {
+            if (targets[j] < targets[i] && longest[j] + 1 > longest[i]) {
+                longest[i] = longest[j] + 1;
+            }
+        }
+        if (longest[i] > longest_in_order) {
+            longest_in_order = longest[i];
+        }
+    }
+    return count - longest_in_order;
+}
+
+#ifdef HEURISTIC_KERNEL_X86
+
+/**
+ * Spreads the 16 nibbles of a packed word into the 16 bytes of a register,
+ * in the order of the cells.
+ * @param {uint64_t} word The packed tiles.
+ * @return {__m128i} the tile of cell i in byte i.
+ */
+__attribute__((target("sse4.1")))
+inline __m128i SpreadNibbles(uint64_t word) {
+    const uint64_t kLowNibbles = 0x0f0f0f0f0f0f0f0fULL;
+    __m128i low = _mm_cvtsi64_si128(static_cast<long long>(
+        word & kLowNibbles));
+    __m128i high = _mm_cvtsi64_si128(static_cast<long long>(
+        (word >> 4) & kLowNibbles));
+    return _mm_unpacklo_epi8(low, high);
+}
+
+/* The row of each lane of the grid, and its column. */
+const signed char kLaneRow[16] = {0, 0, 0, 0, 1, 1, 1, 1,
+                                  2, 2, 2, 2, 3, 3, 3, 3};
+const signed char kLaneColumn[16] = {0, 1, 2, 3, 0, 1, 2, 3,
+                                     0, 1, 2, 3, 0, 1, 2, 3};
+/* The lanes of the grid turned into columns. */
+const signed char kTranspose[16] = {0, 4, 8, 12, 1, 5, 9, 13,
+                                    2, 6, 10, 14, 3, 7, 11, 15};
+/* What the places of a line's tiles are multiplied by to make its key. */
+const signed char kKeyWeights8[16] = {1, 8, 1, 8, 1, 8, 1, 8,
+                                      1, 8, 1, 8, 1, 8, 1, 8};
+const short kKeyWeights16[8] = {1, 64, 1, 64, 1, 64, 1, 64};
+
+/**
+ * Makes the keys of the 4 lines of a grid of tiles, for the conflict
+ * table.
+ * @param {__m128i} line The line of the grid each tile belongs in.
+ * @param {__m128i} place Where along that line it belongs.
+ * @param {__m128i} lane_line The line of the grid each lane is in.
+ * @return {__m128i} the key of each line, 32 bits each.
+ */
+__attribute__((target("sse4.1")))
+inline __m128i LineKeys(__m128i line, __m128i place, __m128i lane_line) {
+    __m128i in_line = _mm_cmpeq_epi8(line, lane_line);
+    __m128i places = _mm_blendv_epi8(_mm_set1_epi8(kNotInLine), place,
+                                     in_line);
+    __m128i pairs = _mm_maddubs_epi16(places, _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(kKeyWeights8)));
+    return _mm_madd_epi16(pairs, _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(kKeyWeights16)));
+}
+
+/**
+ * Sums the conflicts of lines, looked up from their keys.
+ * @param {uint16_t[]} keys The keys.
+ * @param {int} count The number of keys.
+ * @return {int} the number of tiles that must leave their line.
+ */
+inline int SumConflicts(const uint16_t* keys, int count) {
+    int conflicts = 0;
+    for (int i = 0; i < count; ++i) {
+        conflicts += conflict_table.conflicts[keys[i]];
+    }
+    return conflicts;
+}
+
+/* The same vectors as above, for AVX2. */
+
+__attribute__((target("avx2")))
+inline __m256i LineKeys256(__m256i line, __m256i place, __m256i lane_line) {
+    __m256i in_line = _mm256_cmpeq_epi8(line, lane_line);
+    __m256i places = _mm256_blendv_epi8(_mm256_set1_epi8(kNotInLine), place,
+                                        in_line);
+    __m256i pairs = _mm256_maddubs_epi16(places, _mm256_broadcastsi128_si256(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(kKeyWeights8))));
+    return _mm256_madd_epi16(pairs, _mm256_broadcastsi128_si256(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(kKeyWeights16))));
+}
+
+#endif  // HEURISTIC_KERNEL_X86
+
+}  // namespace
+
+/**
+ * Constructor for the HeuristicKernel class.
+ */
+template <int W, int H>
+HeuristicKernel<W, H>::HeuristicKernel() {
+    for (int i = 0; i < (W * H > 16 ? W * H : 16); ++i) {
+        this->goal_row_[i] = kNoLine;
+        this->goal_column_[i] = kNoLine;
+    }
+}
+
+/**
+ * Sets the goal state the states are scored against. The empty space
+ * keeps kNoLine, so it never counts.
+ * @param {int[]} goal_cell The cell each tile belongs in.
+ */
+template <int W, int H>
+void HeuristicKernel<W, H>::SetGoal(const int goal_cell[W * H]) {
+    for (int tile = 1; tile < W * H; ++tile) {
+        this->goal_row_[tile] = static_cast<uint8_t>(goal_cell[tile] / W);
+        this->goal_column_[tile] = static_cast<uint8_t>(goal_cell[tile] % W);
+    }
+}
+
+/**
+ * Scores states with the given implementation.
+ * @param {Implementation} implementation How to score them.
+ * @param {State[]} states The states to score.
+ * @param {int} count The number of states.
+ * @param {boolean} linear_conflict true to add the linear conflicts.
+ * @param {int[]} estimates Filled with the estimate of each state.
+ */
+template <int W, int H>
+void HeuristicKernel<W, H>::ScoreWith(Implementation implementation,
+                                      const State* states, int count,
+                                      bool linear_conflict,
+                                      int* estimates) const {
+    assert(IsAvailable(implementation));
+
+    switch (implementation) {
+        case AVX2:
+            this->ScoreAvx2_(states, count, linear_conflict, estimates);
+            break;
+        case SSE4:
+            this->ScoreSse4_(states, count, linear_conflict, estimates);
+            break;
+        default:
+            this->ScoreScalar_(states, count, linear_conflict, estimates);
+            break;
+    }
+}
+
+/**
+ * Checks if an implementation can be used on this processor, for boards
+ * of this size.
+ * @param {Implementation} implementation The implementation.
+ * @return {boolean} true if it can be used.
+ */
+template <int W, int H>
+bool HeuristicKernel<W, H>::IsAvailable(Implementation implementation) {
+    if (implementation == SCALAR) {
+        return true;
+    }
+#ifdef HEURISTIC_KERNEL_X86
+    if (!kVectorized) {
+        return false;
+    }
+    if (implementation == SSE4) {
+        return __builtin_cpu_supports("sse4.1");
+    }
+    return __builtin_cpu_supports("avx2");
+#else
+    return false;
+#endif
+}
+
+/**
+ * Gets the fastest implementation that can be used, checked once.
+ * @return {Implementation} the implementation.
+ */
+template <int W, int H>
+typename HeuristicKernel<W, H>::Implementation
+HeuristicKernel<W, H>::GetBestImplementation() {
+    static const Implementation best = IsAvailable(AVX2) ? AVX2 :
+        (IsAvailable(SSE4) ? SSE4 : SCALAR);
+    return best;
+}
+
+/**
+ * Gets the name of an implementation.
+ * @param {Implementation} implementation The implementation.
+ * @return {string} "scalar", "sse4" or "avx2".
+ */
+template <int W, int H>
+const char* HeuristicKernel<W, H>::GetName(Implementation implementation) {
+    switch (implementation) {
+        case AVX2:
+            return "avx2";
+        case SSE4:
+            return "sse4";
+        default:
+            return "scalar";
+    }
+}
+
+//////////////////////////////
+// Private helper functions //
+//////////////////////////////
+
+/**
+ * Scores states one tile at a time, with the same result as the vector
+ * implementations.
+ * @private
+ */
+template <int W, int H>
+void HeuristicKernel<W, H>::ScoreScalar_(const State* states, int count,
+                                         bool linear_conflict,
+                                         int* estimates) const {
+    for (int i = 0; i < count; ++i) {
+        const State &state = states[i];
+        int estimate = 0;
+        for (int cell = 0; cell < W * H; ++cell) {
+            int tile = state.Get(cell);
+            if (tile != 0) {
+                estimate += std::abs(cell / W - this->goal_row_[tile]) +
+                    std::abs(cell % W - this->goal_column_[tile]);
+            }
+        }
+        if (linear_conflict) {
+            int conflicts = 0;
+            int targets[W > H ? W : H];
+            for (int row = 0; row < H; ++row) {
+                int in_line = 0;
+                for (int column = 0; column < W; ++column) {
+                    int tile = state.Get(row * W + column);
+                    if (this->goal_row_[tile] == row) {
+                        targets[in_line++] = this->goal_column_[tile];
+                    }
+                }
+                conflicts += CountConflicts(targets, in_line);
+            }
+            for (int column = 0; column < W; ++column) {
+                int in_line = 0;
+                for (int row = 0; row < H; ++row) {
+                    int tile = state.Get(row * W + column);
+                    if (this->goal_column_[tile] == column) {
+                        targets[in_line++] = this->goal_row_[tile];
+                    }
+                }
+                conflicts += CountConflicts(targets, in_line);
+            }
+            estimate += 2 * conflicts;
+        }
+        estimates[i] = estimate;
+    }
+}
+
+#ifdef HEURISTIC_KERNEL_X86
+
+/**
+ * Scores states one at a time, with all 16 lanes of the grid in one
+ * register. The rows of the grid are the rows of the board, and the grid
+ * is transposed to count the conflicts in its columns.
+ * @private
+ */
+template <int W, int H>
+__attribute__((target("sse4.1")))
+void HeuristicKernel<W, H>::ScoreSse4_(const State* states, int count,
+                                       bool linear_conflict,
+                                       int* estimates) const {
+    if (!kVectorized) {
+        this->ScoreScalar_(states, count, linear_conflict, estimates);
+        return;
+    }
+    const __m128i goal_row = _mm_load_si128(
+        reinterpret_cast<const __m128i*>(this->goal_row_));
+    const __m128i goal_column = _mm_load_si128(
+        reinterpret_cast<const __m128i*>(this->goal_column_));
+    const __m128i lane_row = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(kLaneRow));
+    const __m128i lane_column = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(kLaneColumn));
+    const __m128i layout = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(grid_layout<W, H>.grid));
+    const __m128i transpose = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(kTranspose));
+    const __m128i zero = _mm_setzero_si128();
+
+    for (int i = 0; i < count; ++i) {
+        __m128i tiles = SpreadNibbles(states[i].words[0]);
+        if (W != 4 || H != 4) {
+            tiles = _mm_shuffle_epi8(tiles, layout);
+        }
+        // The row and column each tile belongs in.
+        __m128i row = _mm_shuffle_epi8(goal_row, tiles);
+        __m128i column = _mm_shuffle_epi8(goal_column, tiles);
+        __m128i distance = _mm_add_epi8(
+            _mm_abs_epi8(_mm_sub_epi8(row, lane_row)),
+            _mm_abs_epi8(_mm_sub_epi8(column, lane_column)));
+        distance = _mm_andnot_si128(_mm_cmpeq_epi8(tiles, zero), distance);
+        __m128i sums = _mm_sad_epu8(distance, zero);
+        int estimate = _mm_cvtsi128_si32(sums) +
+            _mm_extract_epi16(sums, 4);
+
+        if (linear_conflict) {
+            __m128i row_keys = LineKeys(row, column, lane_row);
+            // In the transposed grid, each row is a column of the board.
+            __m128i column_keys = LineKeys(
+                _mm_shuffle_epi8(column, transpose),
+                _mm_shuffle_epi8(row, transpose), lane_row);
+            alignas(16) uint16_t keys[8];
+            _mm_store_si128(reinterpret_cast<__m128i*>(keys),
+                            _mm_packs_epi32(row_keys, column_keys));
+            estimate += 2 * SumConflicts(keys, 8);
+        }
+        estimates[i] = estimate;
+    }
+}
+
+/**
+ * Scores states two at a time, one in each half of a 256-bit register,
+ * the same way as ScoreSse4_. A last odd state is scored by ScoreSse4_.
+ * @private
+ */
+template <int W, int H>
+__attribute__((target("avx2")))
+void HeuristicKernel<W, H>::ScoreAvx2_(const State* states, int count,
+                                       bool linear_conflict,
+                                       int* estimates) const {
+    if (!kVectorized) {
+        this->ScoreScalar_(states, count, linear_conflict, estimates);
+        return;
+    }
+    const __m256i goal_row = _mm256_broadcastsi128_si256(_mm_load_si128(
+        reinterpret_cast<const __m128i*>(this->goal_row_)));
+    const __m256i goal_column = _mm256_broadcastsi128_si256(_mm_load_si128(
+        reinterpret_cast<const __m128i*>(this->goal_column_)));
+    const __m256i lane_row = _mm256_broadcastsi128_si256(_mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(kLaneRow)));
+    const __m256i lane_column = _mm256_broadcastsi128_si256(_mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(kLaneColumn)));
+    const __m256i layout = _mm256_broadcastsi128_si256(_mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(grid_layout<W, H>.grid)));
+    const __m256i transpose = _mm256_broadcastsi128_si256(_mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(kTranspose)));
+    const __m256i zero = _mm256_setzero_si256();
+
+    int i = 0;
+    for (; i + 1 < count; i += 2) {
+        __m256i tiles = _mm256_inserti128_si256(_mm256_castsi128_si256(
+            SpreadNibbles(states[i].words[0])),
+            SpreadNibbles(states[i + 1].words[0]), 1);
+        if (W != 4 || H != 4) {
+            tiles = _mm256_shuffle_epi8(tiles, layout);
+        }
+        __m256i row = _mm256_shuffle_epi8(goal_row, tiles);
+        __m256i column = _mm256_shuffle_epi8(goal_column, tiles);
+        __m256i distance = _mm256_add_epi8(
+            _mm256_abs_epi8(_mm256_sub_epi8(row, lane_row)),
+            _mm256_abs_epi8(_mm256_sub_epi8(column, lane_column)));
+        distance = _mm256_andnot_si256(_mm256_cmpeq_epi8(tiles, zero),
+                                       distance);
+        // Two sums for each state, one per 64-bit half of its lanes.
+        alignas(32) int64_t sums[4];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(sums),
+                           _mm256_sad_epu8(distance, zero));
+        int first = static_cast<int>(sums[0] + sums[1]);
+        int second = static_cast<int>(sums[2] + sums[3]);
+
+        if (linear_conflict) {
+            __m256i row_keys = LineKeys256(row, column, lane_row);
+            __m256i column_keys = LineKeys256(
+                _mm256_shuffle_epi8(column, transpose),
+                _mm256_shuffle_epi8(row, transpose), lane_row);
+            // The first state's 8 keys, then the second's.
+            alignas(32) uint16_t keys[16];
+            _mm256_store_si256(reinterpret_cast<__m256i*>(keys),
+                               _mm256_packs_epi32(row_keys, column_keys));
+            first += 2 * SumConflicts(keys, 8);
+            second += 2 * SumConflicts(keys + 8, 8);
+        }
+        estimates[i] = first;
+        estimates[i + 1] = second;
+    }
+    if (i < count) {
+        this->ScoreSse4_(states + i, 1, linear_conflict, estimates + i);
+    }
+}
+
+#else
+
+template <int W, int H>
+void HeuristicKernel<W, H>::ScoreSse4_(const State* states, int count,
+                                       bool linear_conflict,
+                                       int* estimates) const {
+    this->ScoreScalar_(states, count, linear_conflict, estimates);
+}
+
+template <int W, int H>
+void HeuristicKernel<W, H>::ScoreAvx2_(const State* states, int count,
+                                       bool linear_conflict,
+                                       int* estimates) const {
+    this->ScoreScalar_(states, count, linear_conflict, estimates);
+}
+
+#endif  // HEURISTIC_KERNEL_X86
+
+// The board sizes the solver supports: the 8-, 15- and 24-puzzle.
+template class HeuristicKernel<3, 3>;
+template class HeuristicKernel<4, 4>;
+template class HeuristicKernel<5, 5>;
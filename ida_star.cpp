@@ -0,0 +1,103 @@
+/////////////////////////////////////////////////
+// Assignment 1 : Lucas Silva                  //
+// The implementation file for the IDA* search //
+/////////////////////////////////////////////////
+
+#include <climits>
+#include <vector>
+#include <cassert>
+
+#include "headers/ida_star.h"
+#include "headers/move_tables.h"
+
+#define FOUND -1          // Returned by Search_ when the goal is reached
+
+/**
+ * Searches for a shortest solution from the given board.
+ * @param {Board} board The initial board, must have been created.
+ * @return {boolean} true if a solution was found.
+ */
+template <int W, int H>
+bool IdaStarSearch<W, H>::Solve(Board<W, H> &board) {
+    assert(board.IsValid());
+
+    this->path_.clear();
+    this->stats_ = SearchStats();
+    this->iterations_ = 0;
+
+    int bound = board.GetRank();
+    while (true) {
+        ++this->iterations_;
+        int result = this->Search_(board, bound, -1);
+        if (result == FOUND) {
+            return true;
+        }
+        // Nothing went over the bound, so every board has been seen.
+        if (result == INT_MAX) {
+            return false;
+        }
+        bound = result;
+    }
+}
+
+//////////////////////////////
+// Private helper functions //
+//////////////////////////////
+
+/**
+ * Depth first search from the board, not going over the bound.
+ * @param {Board} board The board, moved in place.
+ * @param {int} bound The highest rank a board may have.
+ * @param {int} last_direction The direction of the last move.
+ * @return {int} FOUND if the goal was found, otherwise the lowest rank
+ *   that went over the bound.
+ * @private
+ */
+template <int W, int H>
+int IdaStarSearch<W, H>::Search_(Board<W, H> &board, int bound,
+                                 int last_direction) {
+    int rank = board.GetRank();
+    if (rank > bound) {
+        return rank;
+    }
+    if (board.IsAtGoalState()) {
+        return FOUND;
+    }
+    this->stats_.CountExpansion(rank, board.GetMovesMade());
+
+    int lowest_rank_over_bound = INT_MAX;
+    int inverse_of_last = InverseDirection(last_direction);
+    // Only the moves the empty space can make from its cell are tried.
+    const int blank = board.GetState().blank;
+    const int move_count = move_tables<W, H>.move_count[blank];
+    for (int i = 0; i < move_count; ++i) {
+        int direction = move_tables<W, H>.moves[blank][i];
+        // Moving straight back to the previous board is never useful.
+        if (direction == inverse_of_last) {
+            this->stats_.CountParentPrune();
+            continue;
+        }
+        board.MoveInDirection(direction);
+        this->stats_.CountGeneration();
+        this->path_.push_back(direction);
+
+        int result = this->Search_(board, bound, direction);
+        if (result == FOUND) {
+            // Leave the board where it started, the path has the solution.
+            board.UndoMove(direction);
+            return FOUND;
+        }
+        if (result < lowest_rank_over_bound) {
+            lowest_rank_over_bound = result;
+        }
+
+        this->path_.pop_back();
+        board.UndoMove(direction);
+    }
+    return lowest_rank_over_bound;
+}
+
+// The board sizes the solver supports: the 8-, 15- and 24-puzzle.
+template class IdaStarSearch<3, 3>;
+template class IdaStarSearch<4, 4>;
+template class IdaStarSearch<5, 5>;
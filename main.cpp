@@ -4,160 +4,627 @@
 /////////////////////////////////////////////////
 
 #include <iostream>
-#include <queue>          // std::priority_queue
 #include <vector>         // std::vector
-#include <utility>
 #include <string>
+#include <sstream>
+#include <fstream>
+#include <thread>
+#include <cstdlib>
+#include <cstring>
 
 #include "headers/board.h"
+#include "headers/a_star_search.h"
+#include "headers/anytime_search.h"
+#include "headers/ida_star.h"
+#include "headers/hda_star.h"
+#include "headers/bidirectional_search.h"
+#include "headers/distance_table.h"
+#include "headers/pattern_database.h"
+#include "headers/batch_solver.h"
+#include "headers/puzzle_server.h"
+#include "headers/solution_cache.h"
+#include "headers/solver.h"
+#include "headers/perf_counters.h"
 
-#define RIGHT 1
-#define LEFT 2
-#define UP 3
-#define DOWN 4
+#define MANHATTAN 1        // Sum of manhattan distances
+#define LINEAR_CONFLICT 2  // Manhattan distances plus linear conflicts
+#define PATTERN_DATABASE 3 // Additive pattern database
 
-const unsigned int DIRECTIONS[4] = {RIGHT, LEFT, UP, DOWN};
+#define CUSTOM_GOAL 8      // Represents goal states given by the user
+
+#define PARSE_PHASE 0    // Creating the board from the input
+#define SEARCH_PHASE 1   // Searching for a solution
+#define OUTPUT_PHASE 2   // Displaying the solution
+#define TEARDOWN_PHASE 3 // Freeing the search and the board
+
+// The weight the anytime search starts from, unless one is given.
+#define DEFAULT_ANYTIME_WEIGHT 3.0
+
+// Where the 8-puzzle distance table is saved, and mapped from.
+#define DISTANCE_TABLE_FILE "8puzzle_distances.bin"
+
+/**
+ * Starts counting a phase of the solve, if the counters are in use.
+ * @param perf  The counters, NULL if they aren't in use.
+ * @param phase PARSE_PHASE, SEARCH_PHASE, OUTPUT_PHASE or TEARDOWN_PHASE.
+ */
+void StartPhase(PerfCounters* perf, int phase) {
+    if (perf) {
+        perf->Start(phase);
+    }
+}
+
+/**
+ * Writes what a search did as a single line of JSON to stderr.
+ * @param stats The statistics of the search.
+ */
+void WriteStats(const SearchStats &stats) {
+    std::cerr << "Stats: ";
+    stats.WriteJson(std::cerr);
+    std::cerr << std::endl;
+}
+
+/**
+ * Solves the puzzle with A*, and displays the solution step by step.
+ * @param board       The initial board.
+ * @param use_buckets true to use a BucketQueue as the open list.
+ * @param partial_expansion true to expand boards partially (EPEA*).
+ * @param print_stats true to write the search statistics as JSON.
+ * @param perf        The counters of each phase, NULL if not in use.
+ * @return The exit code for main.
+ */
+template <int W, int H>
+int SolveAndDisplay(Board<W, H>* board, bool use_buckets,
+    bool partial_expansion, bool print_stats, PerfCounters* perf) {
+    // Acutally solve the puzzle
+    StartPhase(perf, SEARCH_PHASE);
+    AStarSearch<W, H> search(use_buckets, partial_expansion);
+    if (!search.Solve(*board)) {
+        std::cerr << "Could not find solution" << std::endl;
+        return 1;
+    }
+
+    // Display step-by-step solution
+    StartPhase(perf, OUTPUT_PHASE);
+    std::cout << std::endl << "SOLUTION: " << std::endl << std::endl;
+    board->DisplaySolution(search.GetPath());
+
+    // Report how much work the closed set saved.
+    std::cerr << "States reached: " << search.GetStatesReached() << std::endl;
+    std::cerr << "Duplicates pruned: " << search.GetDuplicatesPruned();
+    std::cerr << std::endl;
+    std::cerr << "Stale nodes skipped: " << search.GetStaleNodesSkipped();
+    std::cerr << std::endl;
+    if (print_stats) {
+        WriteStats(search.GetStats());
+    }
+    // The search frees its closed set and boards on the way out.
+    StartPhase(perf, TEARDOWN_PHASE);
+    return 0;
+}
+
+/**
+ * Solves the puzzle with IDA*, which only keeps the current path in
+ * memory, and displays the solution step by step.
+ * @param board       The initial board, which is back in its initial state
+ *   once the search is done.
+ * @param print_stats true to write the search statistics as JSON.
+ * @param perf        The counters of each phase, NULL if not in use.
+ * @return The exit code for main.
+ */
+template <int W, int H>
+int SolveAndDisplayIdaStar(Board<W, H>* board, bool print_stats,
+    PerfCounters* perf) {
+    StartPhase(perf, SEARCH_PHASE);
+    IdaStarSearch<W, H> search;
+    if (!search.Solve(*board)) {
+        std::cerr << "Could not find solution" << std::endl;
+        return 1;
+    }
+
+    // Display step-by-step solution
+    StartPhase(perf, OUTPUT_PHASE);
+    std::cout << std::endl << "SOLUTION: " << std::endl << std::endl;
+    board->DisplaySolution(search.GetPath());
+
+    // Report how much work the search did.
+    std::cerr << "Nodes expanded: " << search.GetNodesExpanded() << std::endl;
+    std::cerr << "Iterations: " << search.GetIterations() << std::endl;
+    if (print_stats) {
+        WriteStats(search.GetStats());
+    }
+    StartPhase(perf, TEARDOWN_PHASE);
+    return 0;
+}
+
+/**
+ * Solves the puzzle with hash distributed A* on many threads, and displays
+ * the solution step by step.
+ * @param board       The initial board.
+ * @param threads     The number of threads to search on.
+ * @param print_stats true to write the search statistics as JSON.
+ * @param perf        The counters of each phase, NULL if not in use.
+ * @return The exit code for main.
+ */
+template <int W, int H>
+int SolveAndDisplayHdaStar(Board<W, H>* board, int threads,
+    bool print_stats, PerfCounters* perf) {
+    StartPhase(perf, SEARCH_PHASE);
+    HdaStarSearch<W, H> search(threads);
+    if (!search.Solve(*board)) {
+        std::cerr << "Could not find solution" << std::endl;
+        return 1;
+    }
+
+    // Display step-by-step solution
+    StartPhase(perf, OUTPUT_PHASE);
+    std::cout << std::endl << "SOLUTION: " << std::endl << std::endl;
+    board->DisplaySolution(search.GetPath());
+
+    // Report how much work each thread did, and how evenly it was spread.
+    const std::vector<typename HdaStarSearch<W, H>::ThreadStats> &stats =
+        search.GetThreadStats();
+    SearchStats total = search.GetStats();
+    long most_expanded = 0;
+    std::cerr << "Nodes expanded: " << total.expanded << std::endl;
+    for (size_t i = 0; i < stats.size(); ++i) {
+        std::cerr << "Thread " << i << ": " << stats[i].search.expanded;
+        std::cerr << " expanded, " << stats[i].search.generated;
+        std::cerr << " generated, ";
+        std::cerr << stats[i].sent << " sent, " << stats[i].received;
+        std::cerr << " received, " << stats[i].duplicates << " duplicates";
+        std::cerr << std::endl;
+        if (stats[i].search.expanded > most_expanded) {
+            most_expanded = stats[i].search.expanded;
+        }
+    }
+    double mean_expanded = static_cast<double>(total.expanded) / stats.size();
+    std::cerr << "Load balance (max / mean expanded): ";
+    std::cerr << (mean_expanded > 0 ? most_expanded / mean_expanded : 1.0);
+    std::cerr << std::endl;
+    if (print_stats) {
+        WriteStats(total);
+    }
+    StartPhase(perf, TEARDOWN_PHASE);
+    return 0;
+}
+
+/**
+ * Solves the puzzle with a search from both the initial board and the
+ * goal state, and displays the solution step by step.
+ * @param board       The initial board.
+ * @param print_stats true to write the search statistics as JSON.
+ * @param perf        The counters of each phase, NULL if not in use.
+ * @return The exit code for main.
+ */
+template <int W, int H>
+int SolveAndDisplayBidirectional(Board<W, H>* board, bool print_stats,
+    PerfCounters* perf) {
+    StartPhase(perf, SEARCH_PHASE);
+    BidirectionalSearch<W, H> search;
+    if (!search.Solve(*board)) {
+        std::cerr << "Could not find solution" << std::endl;
+        return 1;
+    }
+
+    // Display step-by-step solution
+    StartPhase(perf, OUTPUT_PHASE);
+    std::cout << std::endl << "SOLUTION: " << std::endl << std::endl;
+    board->DisplaySolution(search.GetPath());
+
+    // Report how much work each direction did.
+    std::cerr << "States reached: " << search.GetStatesReached() << std::endl;
+    std::cerr << "Nodes expanded forward: ";
+    std::cerr << search.GetForwardNodesExpanded() << std::endl;
+    std::cerr << "Nodes expanded backward: ";
+    std::cerr << search.GetBackwardNodesExpanded() << std::endl;
+    if (print_stats) {
+        WriteStats(search.GetStats());
+    }
+    StartPhase(perf, TEARDOWN_PHASE);
+    return 0;
+}
+
+/**
+ * Solves the puzzle with weighted A*, or keeps improving the solution with
+ * the anytime search, within a budget. Displays the best solution found
+ * step by step, with how far from the shortest it may be.
+ * @param board       The initial board.
+ * @param settings    The weight and the budget.
+ * @param print_stats true to write the search statistics as JSON.
+ * @param perf        The counters of each phase, NULL if not in use.
+ * @return The exit code for main.
+ */
+template <int W, int H>
+int SolveAndDisplayAnytime(Board<W, H>* board,
+    const AnytimeSettings &settings, bool print_stats, PerfCounters* perf) {
+    StartPhase(perf, SEARCH_PHASE);
+    AnytimeSearch<W, H> search(settings);
+    if (!search.Solve(*board)) {
+        std::cerr << "Could not find solution";
+        if (search.IsOutOfBudget()) {
+            std::cerr << " within the budget";
+        }
+        std::cerr << std::endl;
+        return 1;
+    }
+
+    // Display step-by-step solution
+    StartPhase(perf, OUTPUT_PHASE);
+    std::cout << std::endl << "SOLUTION: " << std::endl << std::endl;
+    board->DisplaySolution(search.GetPath());
+
+    // Report every solution found on the way, and how good the last is.
+    const std::vector<typename AnytimeSearch<W, H>::Improvement>
+        &improvements = search.GetImprovements();
+    for (size_t i = 0; i < improvements.size(); ++i) {
+        std::cerr << "Solution: " << improvements[i].moves << " moves,";
+        std::cerr << " bound " << improvements[i].bound << ", after ";
+        std::cerr << improvements[i].wall_ms << " ms and ";
+        std::cerr << improvements[i].expanded << " expanded" << std::endl;
+    }
+    std::cerr << "Suboptimality bound: " << search.GetBound() << std::endl;
+    if (search.IsOutOfBudget()) {
+        std::cerr << "The budget ran out" << std::endl;
+    }
+    if (print_stats) {
+        WriteStats(search.GetStats());
+    }
+    StartPhase(perf, TEARDOWN_PHASE);
+    return 0;
+}
 
 /**
- * The class used to compare the board pointers in the priority queue.
- * This is just used since the less than operator cannot handle comparing pointers,
- * so this just dereferences the pointers and pass them into the overloaded
- * less than operator. All logic is inside the operator.
+ * Solves the 8-puzzle by walking down the distance table, and displays
+ * the solution step by step.
+ * @param board The initial board.
+ * @param table The distance table, loaded or built.
+ * @param perf  The counters of each phase, NULL if not in use.
+ * @return The exit code for main.
  */
-class QueueCompareClass {
- public:
-    bool operator() (const Board* rhs, const Board* lhs) {
-        return *rhs < *lhs;
+int SolveAndDisplayFromTable(Board<3, 3>* board, const DistanceTable &table,
+    PerfCounters* perf) {
+    StartPhase(perf, SEARCH_PHASE);
+    MoveSequence path;
+    if (!table.FindPath(*board, path)) {
+        std::cerr << "Could not find solution" << std::endl;
+        return 1;
     }
-};
+
+    // Display step-by-step solution
+    StartPhase(perf, OUTPUT_PHASE);
+    std::cout << std::endl << "SOLUTION: " << std::endl << std::endl;
+    board->DisplaySolution(path);
+    StartPhase(perf, TEARDOWN_PHASE);
+    return 0;
+}
+
+/**
+ * The distance table only holds 8-puzzle boards, so larger boards
+ * cannot be solved with it, and the board, table and counters are unused.
+ * @return The exit code for main.
+ */
+template <int W, int H>
+int SolveAndDisplayFromTable(Board<W, H>* /* board */,
+    const DistanceTable & /* table */, PerfCounters* /* perf */) {
+    std::cerr << "The distance table only holds 8-puzzle boards" << std::endl;
+    return 1;
+}
 
 /**
- * Determines if a move can be made in the specified direction.
- * @param  direction One of the four directions.
- * @param  board The board to be checked.
- * @return true if a move in that direction is possible.
+ * Gets the 8-puzzle distance table, mapping it from DISTANCE_TABLE_FILE.
+ * The first time, the table is built and saved to that file.
+ * @param table The table to be loaded.
+ * @return true if the table is ready to use.
  */
-bool CanMoveInDirection(int direction, Board* &board) {
-    switch (direction) {
-        case RIGHT:
-            return board->CanMoveRight();
-        case LEFT:
-            return board->CanMoveLeft();
-        case UP:
-            return board->CanMoveUp();
-        case DOWN:
-            return board->CanMoveDown();
+bool LoadDistanceTable(DistanceTable &table) {
+    if (table.Load(DISTANCE_TABLE_FILE)) {
+        return true;
+    }
+
+    std::cerr << "Building " << DISTANCE_TABLE_FILE << std::endl;
+    table.Build();
+    if (!table.Save(DISTANCE_TABLE_FILE)) {
+        // The built table still works for this run.
+        std::cerr << "Could not save " << DISTANCE_TABLE_FILE << std::endl;
+        return true;
     }
+    return table.Load(DISTANCE_TABLE_FILE);
 }
 
 /**
- * Moves the given board in the given direction
- * @param direction The direction to move in.
- * @param board     The board to be moved.
+ * Creates the board from the user input and solves it, with the search
+ * chosen on the command line.
+ * @param input  The user input.
+ * @param search  HEAP_SEARCH, BUCKET_SEARCH, IDA_STAR_SEARCH, TABLE_WALK,
+ *   HDA_STAR_SEARCH, BIDIRECTIONAL_SEARCH, WEIGHTED_SEARCH or
+ *   PARTIAL_EXPANSION_SEARCH.
+ * @param table   The distance table, used by TABLE_WALK.
+ * @param threads The number of threads, used by HDA_STAR_SEARCH.
+ * @param anytime The weight and budget, used by WEIGHTED_SEARCH.
+ * @param print_stats true to write the search statistics as JSON, which
+ *   TABLE_WALK doesn't have.
+ * @param perf    The counters of each phase, NULL if not in use. They
+ *   are written to stderr once the board is solved.
+ * @return The exit code for main.
  */
-bool MoveInDirection(int direction, Board* &board) {
-    switch (direction) {
-        case RIGHT:
-            board->MoveRight();
+template <int W, int H>
+int CreateAndSolve(const std::string &input, int search,
+    const DistanceTable &table, int threads, const AnytimeSettings &anytime,
+    bool print_stats, PerfCounters* perf) {
+    // Create a board object from the input string.
+    StartPhase(perf, PARSE_PHASE);
+    Board<W, H>* board = new Board<W, H>(input);
+
+    if (board->CreateBoard()) {
+        if (board->IsAtGoalState()) {
+            std::cout << "Looks like board is already at the goal state!";
+            std::cout << std::endl;
+            delete board;
+            return 1;
+        }
+        if (!board->IsSolvable()) {
+            std::cout << "This board is not solvable" << std::endl;
+            delete board;
+            return 1;
+        }
+    } else {
+        std::cerr << "Board could not be created!" << std::endl;
+        delete board;
+        return 1;
+    }
+
+    int exit_code;
+    switch (search) {
+        case TABLE_WALK:
+            exit_code = SolveAndDisplayFromTable(board, table, perf);
+            break;
+        case IDA_STAR_SEARCH:
+            exit_code = SolveAndDisplayIdaStar(board, print_stats, perf);
+            break;
+        case HDA_STAR_SEARCH:
+            exit_code = SolveAndDisplayHdaStar(board, threads, print_stats,
+                                               perf);
+            break;
+        case BIDIRECTIONAL_SEARCH:
+            exit_code = SolveAndDisplayBidirectional(board, print_stats,
+                                                     perf);
+            break;
+        case WEIGHTED_SEARCH:
+            exit_code = SolveAndDisplayAnytime(board, anytime, print_stats,
+                                               perf);
             break;
-        case LEFT:
-            board->MoveLeft();
+        case PARTIAL_EXPANSION_SEARCH:
+            exit_code = SolveAndDisplay(board, true, true, print_stats,
+                                        perf);
             break;
-        case UP:
-            board->MoveUp();
+        case BUCKET_SEARCH:
+            exit_code = SolveAndDisplay(board, true, false, print_stats,
+                                        perf);
             break;
-        case DOWN:
-            board->MoveDown();
+        default:
+            exit_code = SolveAndDisplay(board, false, false, print_stats,
+                                        perf);
             break;
     }
+
+    delete board;
+    if (perf) {
+        perf->Stop();
+        perf->Write(std::cerr);
+    }
+
+    return exit_code;
+}
+
+/**
+ * Gets the file the pattern database for a board size is saved to.
+ * @return The file name, e.g. 15puzzle_pdb.bin for the 15-puzzle.
+ */
+template <int W, int H>
+std::string GetPatternDatabaseFile() {
+    std::ostringstream name;
+    name << W * H - 1 << "puzzle_pdb.bin";
+    return name.str();
+}
+
+/**
+ * Builds the pattern database for a board size and saves it, so that
+ * later runs with --pdb only have to load it.
+ * @return true if the database was saved.
+ */
+template <int W, int H>
+bool BuildPatternDatabase() {
+    std::string file = GetPatternDatabaseFile<W, H>();
+    std::cerr << "Building " << file << std::endl;
+    PatternDatabase<W, H> database;
+    database.Build();
+    if (!database.Save(file)) {
+        std::cerr << "Could not save " << file << std::endl;
+        return false;
+    }
     return true;
 }
 
 /**
- * Moves a board in all the possible directions and adds the new states to the queue.
- * @param board The board to be moved.
- * @param queue The priority queue holding all board states.
- */
-std::pair<bool, Board*> MoveAllDirectionsAndAddToQueue(Board* &board,
-    std::priority_queue<Board*, std::vector<Board*>, QueueCompareClass> &queue) {
-
-    // For all 4 directions, try to move in that direction.
-    for (unsigned int i = 0; i < 4; ++i) {
-        int direction = DIRECTIONS[i];
-        // If the board can move in that direction, then move it.
-        // If it can't, then do nothing.
-        if (CanMoveInDirection(direction, board)) {
-            // Create a copy of the current board, and move the copy.
-            Board* new_board = new Board(*board);
-            // Actually move the board.
-            MoveInDirection(direction, new_board);
-            // Set the previous board state.
-            new_board->SetPreviousState(board);
-            // Check if the board is at the goal state, if so then stop.
-            if (new_board->IsAtGoalState()) {
-                return std::make_pair(true, new_board);
-            }
-            // Do not add the new state to the queue if the new board is the
-            // same as the previous state.
-            if (board->GetPreviousState() &&
-                *(board->GetPreviousState()) == *new_board) {
-                delete new_board;
-                new_board = NULL;
-            } else {
-                queue.push(new_board);
-            }
-        }
+ * Sets the heuristic used by every board of a size. The pattern database
+ * is loaded from the file --build-pdb saved it to.
+ * @param heuristic MANHATTAN, LINEAR_CONFLICT or PATTERN_DATABASE.
+ * @param database  Loaded for PATTERN_DATABASE, must stay alive while
+ *   the boards are used.
+ * @return false if the pattern database could not be loaded.
+ */
+template <int W, int H>
+bool SetHeuristic(int heuristic, PatternDatabase<W, H> &database) {
+    Board<W, H>::SetLinearConflict(heuristic == LINEAR_CONFLICT);
+    Board<W, H>::SetPatternDatabase(NULL);
+    if (heuristic != PATTERN_DATABASE) {
+        return true;
     }
 
-    return std::make_pair(false, reinterpret_cast<Board*>(NULL));
+    if (!database.Load(GetPatternDatabaseFile<W, H>())) {
+        std::cerr << "Could not load " << GetPatternDatabaseFile<W, H>();
+        std::cerr << ", run with --build-pdb first" << std::endl;
+        return false;
+    }
+    Board<W, H>::SetPatternDatabase(&database);
+    return true;
 }
 
-Board* Solve(std::priority_queue<Board*, std::vector<Board*>,
-    QueueCompareClass> &pq, std::vector<Board*> &to_delete) {
-    // While the board isn't empty, try to find the solution.
-    while (!pq.empty()) {
-        // Get the board with least rank from the top of the queue.
-        // Rank = moves made so far + estimated number of moves remaining
-        Board* board = pq.top();
+/**
+ * Solves the board from the user input, with the heuristic chosen on the
+ * command line.
+ * @param input     The user input.
+ * @param search    HEAP_SEARCH, BUCKET_SEARCH, IDA_STAR_SEARCH, TABLE_WALK,
+ *   HDA_STAR_SEARCH, BIDIRECTIONAL_SEARCH, WEIGHTED_SEARCH or
+ *   PARTIAL_EXPANSION_SEARCH.
+ * @param table     The distance table, used by TABLE_WALK.
+ * @param heuristic MANHATTAN, LINEAR_CONFLICT or PATTERN_DATABASE.
+ * @param threads   The number of threads, used by HDA_STAR_SEARCH.
+ * @param anytime   The weight and budget, used by WEIGHTED_SEARCH.
+ * @param print_stats true to write the search statistics as JSON.
+ * @param perf      The counters of each phase, NULL if not in use.
+ * @return The exit code for main.
+ */
+template <int W, int H>
+int SolveWithHeuristic(const std::string &input, int search,
+    const DistanceTable &table, int heuristic, int threads,
+    const AnytimeSettings &anytime, bool print_stats, PerfCounters* perf) {
+    PatternDatabase<W, H> database;
+    if (!SetHeuristic(heuristic, database)) {
+        return 1;
+    }
+    int exit_code = CreateAndSolve<W, H>(input, search, table, threads,
+                                         anytime, print_stats, perf);
+    SetHeuristic(MANHATTAN, database);
+    return exit_code;
+}
 
-        // Move in all directions, adding the boards to the queue.
-        std::pair<bool, Board*> result =
-          MoveAllDirectionsAndAddToQueue(board, pq);
+/**
+ * Adds a goal state given on the command line to the custom goal states
+ * of its board size.
+ * @param tiles The tiles of the goal state, row by row.
+ * @param goals The custom goal states of the board size so far.
+ * @return false if the tiles aren't a goal state of that size, or the
+ *   size already has as many goal states as a board can be solved towards.
+ */
+template <int W, int H>
+bool AddCustomGoal(const std::vector<int> &tiles,
+                   std::vector<GoalState<W, H> > &goals) {
+    const size_t kMaxGoals = ProblemContext<W, H>::kMaxGoals;
+    if (goals.size() >= kMaxGoals) {
+        return false;
+    }
+    GoalState<W, H> goal;
+    if (!goal.Create(tiles, CUSTOM_GOAL)) {
+        return false;
+    }
+    goals.push_back(goal);
+    return true;
+}
 
-        // If the goal state has been reached, then we are done!
-        if (result.first) {
-            return result.second;
-        }
+/**
+ * Writes the counters of the solution cache to stderr, if there is one.
+ * @param cache The cache, NULL if there is none.
+ */
+void WriteCacheStats(const SolutionCache* cache) {
+    if (cache) {
+        std::cerr << "Cache: ";
+        cache->GetStats().WriteJson(std::cerr);
+        std::cerr << std::endl;
+    }
+}
 
-        pq.pop();
-        to_delete.push_back(board);
+/**
+ * Solves every board in a file, or on stdin for "-", on a pool of threads,
+ * and writes a line of result for each one to stdout.
+ * @param path      The file to read the boards from.
+ * @param threads   The number of threads to solve on.
+ * @param options   How to solve every board.
+ * @param table     The distance table, used by TABLE_WALK.
+ * @param heuristic MANHATTAN, LINEAR_CONFLICT or PATTERN_DATABASE.
+ * @param cache     The cache of solutions, NULL if there is none.
+ * @return The exit code for main.
+ */
+int SolveBatch(const std::string &path, int threads,
+    const SolveOptions &options, const DistanceTable &table, int heuristic,
+    SolutionCache* cache) {
+    // A batch can mix board sizes, so every size gets the heuristic.
+    PatternDatabase<3, 3> database_3x3;
+    PatternDatabase<4, 4> database_4x4;
+    PatternDatabase<5, 5> database_5x5;
+    if (!SetHeuristic(heuristic, database_3x3) ||
+        !SetHeuristic(heuristic, database_4x4) ||
+        !SetHeuristic(heuristic, database_5x5)) {
+        return 1;
     }
 
-    // No goal state was found!
-    reinterpret_cast<Board*>(NULL);
-}
+    BatchSolver solver(options, threads, table, cache);
+    int solved;
+    if (path == "-") {
+        solved = solver.Run(std::cin, std::cout);
+    } else {
+        std::ifstream file(path.c_str());
+        if (!file) {
+            std::cerr << "Could not open " << path << std::endl;
+            return 1;
+        }
+        solved = solver.Run(file, std::cout);
+    }
+    std::cerr << "Boards solved: " << solved << std::endl;
+    WriteCacheStats(cache);
 
-void Cleanup(std::priority_queue<Board*, std::vector<Board*>,
-    QueueCompareClass> &pq, std::vector<Board*> to_delete) {
+    SetHeuristic(MANHATTAN, database_3x3);
+    SetHeuristic(MANHATTAN, database_4x4);
+    SetHeuristic(MANHATTAN, database_5x5);
+    return 0;
+}
 
-    for (unsigned int i = 0; i < to_delete.size(); ++i) {
-        delete to_delete[i];
-        to_delete[i] = NULL;
+/**
+ * Keeps answering boards, one per line, from stdin or from the connections
+ * to a Unix domain socket, until the input ends or the server is stopped.
+ * The pattern databases are loaded once, before the first board.
+ * @param socket_path The path of the socket, NULL to read from stdin.
+ * @param threads     The number of workers serving the socket.
+ * @param options     How to solve every board.
+ * @param table       The distance table, used by TABLE_WALK.
+ * @param heuristic   MANHATTAN, LINEAR_CONFLICT or PATTERN_DATABASE.
+ * @param cache       The cache of solutions, NULL if there is none.
+ * @return The exit code for main.
+ */
+int Serve(const char* socket_path, int threads, const SolveOptions &options,
+    const DistanceTable &table, int heuristic, SolutionCache* cache) {
+    // Boards of any size can come in, so every size gets the heuristic.
+    PatternDatabase<3, 3> database_3x3;
+    PatternDatabase<4, 4> database_4x4;
+    PatternDatabase<5, 5> database_5x5;
+    if (!SetHeuristic(heuristic, database_3x3) ||
+        !SetHeuristic(heuristic, database_4x4) ||
+        !SetHeuristic(heuristic, database_5x5)) {
+        return 1;
     }
 
-    while (!pq.empty()) {
-        Board* board = pq.top();
-        pq.pop();
-        delete board;
-        board = NULL;
+    PuzzleServer server(options, threads, table, cache);
+    int exit_code = 0;
+    if (socket_path) {
+        exit_code = server.ServeSocket(socket_path) ? 0 : 1;
+    } else {
+        int solved = server.ServeStream(std::cin, std::cout);
+        std::cerr << "Boards solved: " << solved << std::endl;
+        WriteCacheStats(cache);
     }
+
+    SetHeuristic(MANHATTAN, database_3x3);
+    SetHeuristic(MANHATTAN, database_4x4);
+    SetHeuristic(MANHATTAN, database_5x5);
+    return exit_code;
 }
 
 /**
  * Gets the initial board from the user.
- * @return {Board*} The constructed board.
+ * @return {string} The board string the user entered.
  */
-Board* GetBoardFromUser() {
+std::string GetBoardFromUser() {
     std::cout << std::endl;
     std::cout << "DIRECTIONS: " << std::endl;
     std::cout << "Please enter the puzzle board a single string," << std::endl;
@@ -166,6 +633,8 @@ Board* GetBoardFromUser() {
     std::cout << std::endl;
     std::cout << "ex: goal state would be '1 2 3 4 5 6 7 8 0'" << std::endl;
     std::cout << "(with or without spaces between numbers)" << std::endl;
+    std::cout << "15- and 24-puzzles are entered the same way," << std::endl;
+    std::cout << "with spaces between numbers." << std::endl;
 
     std::cout << std::endl;
 
@@ -173,52 +642,237 @@ Board* GetBoardFromUser() {
     std::cout << "Enter board string: " << std::endl;
     std::getline(std::cin, input);
 
-    return new Board(input);
+    return input;
 }
 
 ///////////////////
 // Start of main //
 ///////////////////
 
-int main() {
-    // The priority queue to hold all the board states.
-    std::priority_queue<Board*, std::vector<Board*>, QueueCompareClass> pq;
-
-    std::vector<Board*> to_delete;
-
-    // Create a board object from the input string.
-    Board* board = GetBoardFromUser();
-
-    if (board->CreateBoard()) {
-        if (board->IsAtGoalState()) {
-            std::cout << "Looks like board is already at the goal state!";
-            std::cout << std::endl;
-            return 1;
-        }
-        if (!board->IsSolvable()) {
-            std::cout << "This board is not solvable" << std::endl;
+int main(int argc, char* argv[]) {
+    // Use A* with the binary heap as the open list unless asked for
+    // buckets or partial expansion, for IDA*, HDA*, a bidirectional,
+    // weighted or anytime search instead of A*, or for the distance table.
+    SearchKind search = HEAP_SEARCH;
+    // Likewise, the manhattan distances are the heuristic by default.
+    int heuristic = MANHATTAN;
+    bool build_pattern_databases = false;
+    // What the search did is only written out when asked for.
+    bool print_stats = false;
+    // So are the hardware counters of each phase of the solve.
+    bool count_phases = false;
+    // Boards are read from the user, unless a batch file is given, or
+    // the solver is asked to serve boards from stdin or a socket.
+    const char* batch_file = NULL;
+    bool serve = false;
+    const char* socket_path = NULL;
+    // Those can keep the solutions they find, for boards that come again.
+    long cache_capacity = 0;
+    int threads = std::thread::hardware_concurrency();
+    // The weight and budget of weighted A* and the anytime search.
+    AnytimeSettings anytime;
+    bool weight_given = false;
+    // Boards are solved towards the goal states given for their size, if
+    // any, instead of the standard ones.
+    std::vector<GoalState<3, 3> > goals_3x3;
+    std::vector<GoalState<4, 4> > goals_4x4;
+    std::vector<GoalState<5, 5> > goals_5x5;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--buckets") == 0) {
+            search = BUCKET_SEARCH;
+        } else if (std::strcmp(argv[i], "--epea") == 0) {
+            search = PARTIAL_EXPANSION_SEARCH;
+        } else if (std::strcmp(argv[i], "--ida") == 0) {
+            search = IDA_STAR_SEARCH;
+        } else if (std::strcmp(argv[i], "--hda") == 0) {
+            search = HDA_STAR_SEARCH;
+        } else if (std::strcmp(argv[i], "--bidirectional") == 0) {
+            search = BIDIRECTIONAL_SEARCH;
+        } else if (std::strcmp(argv[i], "--table") == 0) {
+            search = TABLE_WALK;
+        } else if (std::strcmp(argv[i], "--pdb") == 0) {
+            heuristic = PATTERN_DATABASE;
+        } else if (std::strcmp(argv[i], "--linear-conflict") == 0) {
+            heuristic = LINEAR_CONFLICT;
+        } else if (std::strcmp(argv[i], "--stats") == 0) {
+            print_stats = true;
+        } else if (std::strcmp(argv[i], "--perf") == 0) {
+            count_phases = true;
+        } else if (std::strcmp(argv[i], "--build-pdb") == 0) {
+            build_pattern_databases = true;
+        } else if (std::strcmp(argv[i], "--batch") == 0 && i + 1 < argc) {
+            batch_file = argv[++i];
+        } else if (std::strcmp(argv[i], "--server") == 0) {
+            serve = true;
+        } else if (std::strcmp(argv[i], "--socket") == 0 && i + 1 < argc) {
+            serve = true;
+            socket_path = argv[++i];
+        } else if (std::strcmp(argv[i], "--cache") == 0 && i + 1 < argc &&
+                   std::atol(argv[i + 1]) > 0) {
+            cache_capacity = std::atol(argv[++i]);
+        } else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc &&
+                   std::atoi(argv[i + 1]) > 0) {
+            threads = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--weight") == 0 && i + 1 < argc &&
+                   std::atof(argv[i + 1]) >= 1) {
+            search = WEIGHTED_SEARCH;
+            anytime.weight = std::atof(argv[++i]);
+            weight_given = true;
+        } else if (std::strcmp(argv[i], "--anytime") == 0) {
+            search = WEIGHTED_SEARCH;
+            anytime.improve = true;
+        } else if (std::strcmp(argv[i], "--time-limit") == 0 &&
+                   i + 1 < argc && std::atol(argv[i + 1]) > 0) {
+            search = WEIGHTED_SEARCH;
+            anytime.time_limit_ms = std::atol(argv[++i]);
+        } else if (std::strcmp(argv[i], "--node-limit") == 0 &&
+                   i + 1 < argc && std::atol(argv[i + 1]) > 0) {
+            search = WEIGHTED_SEARCH;
+            anytime.node_limit = std::atol(argv[++i]);
+        } else if (std::strcmp(argv[i], "--goal") == 0 && i + 1 < argc) {
+            // The number of tiles decides the size, like for a board.
+            std::vector<int> goal_tiles;
+            bool added = ParseTiles(argv[++i], goal_tiles);
+            switch (goal_tiles.size()) {
+                case 16:
+                    added = added && AddCustomGoal(goal_tiles, goals_4x4);
+                    break;
+                case 25:
+                    added = added && AddCustomGoal(goal_tiles, goals_5x5);
+                    break;
+                default:
+                    added = added && AddCustomGoal(goal_tiles, goals_3x3);
+                    break;
+            }
+            if (!added) {
+                std::cerr << "Invalid goal state: " << argv[i] << std::endl;
+                std::cerr << "A goal state has every tile once, and each ";
+                std::cerr << "board size can have up to ";
+                std::cerr << ProblemContext<3, 3>::kMaxGoals << std::endl;
+                return 1;
+            }
+        } else {
+            std::cerr << "Unknown option: " << argv[i] << std::endl;
+            std::cerr << "Usage: " << argv[0];
+            std::cerr << " [--buckets | --epea | --ida | --hda |";
+            std::cerr << " --bidirectional | --table]" << std::endl;
+            std::cerr << "          ";
+            std::cerr << " [--linear-conflict | --pdb]" << std::endl;
+            std::cerr << "           [--batch FILE | --batch - | --server |";
+            std::cerr << " --socket PATH]" << std::endl;
+            std::cerr << "           [--cache N] [--threads N] [--stats]";
+            std::cerr << " [--perf]" << std::endl;
+            std::cerr << "           [--weight W] [--anytime]";
+            std::cerr << " [--time-limit MS] [--node-limit N]" << std::endl;
+            std::cerr << "           [--goal TILES]..." << std::endl;
+            std::cerr << "       " << argv[0] << " --build-pdb" << std::endl;
             return 1;
         }
-        // Add the board to the queue.
-        pq.push(board);
-    } else {
-        std::cerr << "Board could not be created!" << std::endl;
+    }
+
+    // The pattern databases and the distance table only know the two
+    // standard goal states.
+    bool custom_goals = !goals_3x3.empty() || !goals_4x4.empty() ||
+                        !goals_5x5.empty();
+    if (custom_goals &&
+        (heuristic == PATTERN_DATABASE || search == TABLE_WALK)) {
+        std::cerr << "--goal can't be used with --pdb or --table" << std::endl;
         return 1;
     }
+    if (!goals_3x3.empty()) {
+        Board<3, 3>::SetCustomGoals(&goals_3x3);
+    }
+    if (!goals_4x4.empty()) {
+        Board<4, 4>::SetCustomGoals(&goals_4x4);
+    }
+    if (!goals_5x5.empty()) {
+        Board<5, 5>::SetCustomGoals(&goals_5x5);
+    }
 
-    // Acutally solve the puzzle
-    Board* answer = Solve(pq, to_delete);
-    if (!answer) {
-        std::cerr << "Could not find solution" << std::endl;
+    // The anytime search starts from a high weight, to find a first
+    // solution quickly.
+    if (anytime.improve && !weight_given) {
+        anytime.weight = DEFAULT_ANYTIME_WEIGHT;
+    }
+
+    // Building the pattern databases is a separate step from solving.
+    if (build_pattern_databases) {
+        bool saved = BuildPatternDatabase<3, 3>() &&
+                     BuildPatternDatabase<4, 4>() &&
+                     BuildPatternDatabase<5, 5>();
+        return saved ? 0 : 1;
+    }
+
+    // The table is mapped before any input, so a solve is only lookups.
+    DistanceTable table;
+    if (search == TABLE_WALK && !LoadDistanceTable(table)) {
+        std::cerr << "Could not load " << DISTANCE_TABLE_FILE << std::endl;
         return 1;
     }
 
-    // Display step-by-step solution
-    std::cout << std::endl << "SOLUTION: " << std::endl << std::endl;
-    answer->DisplayAllSteps();
+    if (batch_file || serve) {
+        // A batch or a server already keeps every thread busy with boards
+        // of its own, so HDA* is replaced by plain A*. The weight and
+        // budget apply to each board.
+        SolveOptions options;
+        options.search = search == HDA_STAR_SEARCH ? HEAP_SEARCH : search;
+        options.anytime = anytime;
+        SolutionCache* cache = NULL;
+        if (cache_capacity > 0) {
+            cache = new SolutionCache(static_cast<size_t>(cache_capacity));
+        }
+        int exit_code;
+        if (batch_file) {
+            exit_code = SolveBatch(batch_file, threads, options, table,
+                                   heuristic, cache);
+        } else {
+            exit_code = Serve(socket_path, threads, options, table,
+                              heuristic, cache);
+        }
+        delete cache;
+        return exit_code;
+    }
 
-    // Delete all dynamically allocated memory.
-    Cleanup(pq, to_delete);
+    std::string input = GetBoardFromUser();
 
-    return 0;
+    // The counters are opened before the clock starts on any phase.
+    PerfCounters* perf = NULL;
+    if (count_phases) {
+        std::vector<std::string> phase_names;
+        phase_names.push_back("parse");
+        phase_names.push_back("search");
+        phase_names.push_back("output");
+        phase_names.push_back("teardown");
+        perf = new PerfCounters(phase_names);
+        if (!perf->IsAvailable()) {
+            std::cerr << "No hardware counters are available, only the ";
+            std::cerr << "wall time of each phase is measured" << std::endl;
+        }
+    }
+
+    // The number of tiles decides the size of the board. Anything that
+    // isn't a 15- or 24-puzzle is read as an 8-puzzle, which reports
+    // what is wrong with the input.
+    std::vector<int> tiles;
+    ParseTiles(input, tiles);
+    int exit_code;
+    switch (tiles.size()) {
+        case 16:
+            exit_code = SolveWithHeuristic<4, 4>(input, search, table,
+                                                 heuristic, threads, anytime,
+                                                 print_stats, perf);
+            break;
+        case 25:
+            exit_code = SolveWithHeuristic<5, 5>(input, search, table,
+                                                 heuristic, threads, anytime,
+                                                 print_stats, perf);
+            break;
+        default:
+            exit_code = SolveWithHeuristic<3, 3>(input, search, table,
+                                                 heuristic, threads, anytime,
+                                                 print_stats, perf);
+            break;
+    }
+    delete perf;
+    return exit_code;
 }
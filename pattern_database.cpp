@@ -0,0 +1,295 @@
+//////////////////////////////////////////////////////
+// Assignment 1 : Lucas Silva                       //
+// The implementation file for the pattern database //
+//////////////////////////////////////////////////////
+
+#include <stdint.h>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cassert>
+
+#include "headers/pattern_database.h"
+
+#define TOP_LEFT 5        // Represents a goal state with empty space at top left
+#define BOTTOM_RIGHT 6    // Represents a goal state with empty space at bottom right
+
+namespace {
+
+/* Written at the start of saved tables, followed by the width and height. */
+const char MAGIC[6] = {'P', 'A', 'T', 'T', 'D', 'B'};
+
+/* Stored for the placements the search has not reached yet. */
+const uint8_t UNREACHED = 0xFF;
+
+/**
+ * Gets the index for a goal state.
+ * @param {int} goal_state_type TOP_LEFT or BOTTOM_RIGHT.
+ * @return {int} 0 for TOP_LEFT, 1 for BOTTOM_RIGHT.
+ */
+int GoalIndex(int goal_state_type) {
+    return (goal_state_type == TOP_LEFT) ? 0 : 1;
+}
+
+/**
+ * Ranks the cells of a group's tiles as a partial permutation, so every
+ * placement of the group gets its own index in [0, kEntriesPerTable).
+ * @param {int[]} cells The cell of each tile of the group.
+ * @return {uint32_t} the rank of the placement.
+ */
+template <int kCells, int kGroupSize>
+uint32_t RankCells(const int cells[kGroupSize]) {
+    uint32_t rank = 0;
+    for (int i = 0; i < kGroupSize; ++i) {
+        // The cell, counted among the cells no earlier tile is in.
+        int digit = cells[i];
+        for (int j = 0; j < i; ++j) {
+            if (cells[j] < cells[i]) {
+                --digit;
+            }
+        }
+        rank = rank * (kCells - i) + digit;
+    }
+    return rank;
+}
+
+/**
+ * Gets the cells of a group's tiles from their rank, the inverse of
+ * RankCells.
+ * @param {uint32_t} rank The rank of the placement.
+ * @param {int[]} cells Filled with the cell of each tile of the group.
+ */
+template <int kCells, int kGroupSize>
+void UnrankCells(uint32_t rank, int cells[kGroupSize]) {
+    int digits[kGroupSize];
+    for (int i = kGroupSize - 1; i >= 0; --i) {
+        digits[i] = rank % (kCells - i);
+        rank /= (kCells - i);
+    }
+
+    bool used[kCells];
+    for (int i = 0; i < kCells; ++i) {
+        used[i] = false;
+    }
+    for (int i = 0; i < kGroupSize; ++i) {
+        int cell = 0;
+        for (int skipped = 0; used[cell] || skipped < digits[i]; ++cell) {
+            if (!used[cell]) {
+                ++skipped;
+            }
+        }
+        cells[i] = cell;
+        used[cell] = true;
+    }
+}
+
+}  // namespace
+
+/**
+ * Builds the tables for every group and both goal states.
+ */
+template <int W, int H>
+void PatternDatabase<W, H>::Build() {
+    this->tables_.assign(2 * kGroups * kEntriesPerTable, UNREACHED);
+    for (int goal = 0; goal < 2; ++goal) {
+        for (int group = 0; group < kGroups; ++group) {
+            this->BuildTable_(goal, group);
+        }
+    }
+}
+
+/**
+ * Loads the tables saved by Save.
+ * @param {string} path The file to be read.
+ * @return {boolean} true if the file held valid tables for this size.
+ */
+template <int W, int H>
+bool PatternDatabase<W, H>::Load(const std::string &path) {
+    std::ifstream file(path.c_str(), std::ios::in | std::ios::binary);
+    char header[sizeof(MAGIC) + 2];
+    if (!file.read(header, sizeof(header)) ||
+        std::memcmp(header, MAGIC, sizeof(MAGIC)) != 0 ||
+        header[sizeof(MAGIC)] != W || header[sizeof(MAGIC) + 1] != H) {
+        return false;
+    }
+
+    std::vector<uint8_t> tables(2 * kGroups * kEntriesPerTable);
+    if (!file.read(reinterpret_cast<char*>(&tables[0]), tables.size()) ||
+        file.peek() != EOF) {
+        return false;
+    }
+    this->tables_.swap(tables);
+    return true;
+}
+
+/**
+ * Saves the tables to a file, so they can be read by Load.
+ * @param {string} path The file to be written.
+ * @return {boolean} true if every table was written.
+ */
+template <int W, int H>
+bool PatternDatabase<W, H>::Save(const std::string &path) const {
+    assert(!this->tables_.empty());
+
+    std::ofstream file(path.c_str(), std::ios::out | std::ios::binary);
+    file.write(MAGIC, sizeof(MAGIC));
+    const char size[2] = {W, H};
+    file.write(size, sizeof(size));
+    file.write(reinterpret_cast<const char*>(&this->tables_[0]),
+               this->tables_.size());
+    file.close();
+    return !file.fail();
+}
+
+/**
+ * Gets the estimated moves remaining for the tiles of one group.
+ * @param {State} state The board state.
+ * @param {int} goal_state_type TOP_LEFT or BOTTOM_RIGHT.
+ * @param {int} group The group.
+ * @return {int} the moves the group needs at the least.
+ */
+template <int W, int H>
+int PatternDatabase<W, H>::GetGroupEstimate(const State &state,
+    int goal_state_type, int group) const {
+    int cells[kGroupSize];
+    for (int cell = 0; cell < kCells; ++cell) {
+        int tile = state.Get(cell);
+        if (tile != 0 && GetGroup(tile) == group) {
+            cells[(tile - 1) % kGroupSize] = cell;
+        }
+    }
+    int table = GoalIndex(goal_state_type) * kGroups + group;
+    return this->tables_[table * kEntriesPerTable +
+                         RankCells<kCells, kGroupSize>(cells)];
+}
+
+/**
+ * Gets the estimated moves remaining, the sum over every group.
+ * @param {State} state The board state.
+ * @param {int} goal_state_type TOP_LEFT or BOTTOM_RIGHT.
+ * @return {int} the estimated moves remaining.
+ */
+template <int W, int H>
+int PatternDatabase<W, H>::GetEstimate(const State &state,
+                                       int goal_state_type) const {
+    int cells[kGroups][kGroupSize];
+    for (int cell = 0; cell < kCells; ++cell) {
+        int tile = state.Get(cell);
+        if (tile != 0) {
+            cells[GetGroup(tile)][(tile - 1) % kGroupSize] = cell;
+        }
+    }
+    int estimate = 0;
+    for (int group = 0; group < kGroups; ++group) {
+        int table = GoalIndex(goal_state_type) * kGroups + group;
+        estimate += this->tables_[table * kEntriesPerTable +
+                                  RankCells<kCells, kGroupSize>(cells[group])];
+    }
+    return estimate;
+}
+
+//////////////////////////////
+// Private helper functions //
+//////////////////////////////
+
+/**
+ * Fills the table of one group and goal state. The search runs over the
+ * cells of the group's tiles together with the cell of the empty space,
+ * and moving the empty space costs a move only when it swaps with a tile
+ * of the group, so it is a breadth first search with 0 and 1 costs.
+ * @param {int} goal The goal index, 0 for TOP_LEFT, 1 for BOTTOM_RIGHT.
+ * @param {int} group The group.
+ * @private
+ */
+template <int W, int H>
+void PatternDatabase<W, H>::BuildTable_(int goal, int group) {
+    // In the goal state, tile t is in cell t, or in cell t - 1 when the
+    // empty space is at the bottom right.
+    int cells[kGroupSize];
+    for (int i = 0; i < kGroupSize; ++i) {
+        int tile = group * kGroupSize + i + 1;
+        cells[i] = (goal == 0) ? tile : tile - 1;
+    }
+    int goal_blank = (goal == 0) ? 0 : kCells - 1;
+
+    // The moves needed for each placement of the group and empty space.
+    std::vector<uint8_t> distances(
+        static_cast<size_t>(kEntriesPerTable) * kCells, UNREACHED);
+    std::deque<uint32_t> queue;
+    uint32_t start = RankCells<kCells, kGroupSize>(cells) * kCells +
+        goal_blank;
+    distances[start] = 0;
+    queue.push_back(start);
+
+    while (!queue.empty()) {
+        uint32_t current = queue.front();
+        queue.pop_front();
+        uint32_t rank = current / kCells;
+        int blank = current % kCells;
+        uint8_t distance = distances[current];
+
+        UnrankCells<kCells, kGroupSize>(rank, cells);
+        int tile_in[kCells];
+        for (int i = 0; i < kCells; ++i) {
+            tile_in[i] = -1;
+        }
+        for (int i = 0; i < kGroupSize; ++i) {
+            tile_in[cells[i]] = i;
+        }
+
+        int row = blank / W;
+        int column = blank % W;
+        int neighbours[4] = {
+            column < W - 1 ? blank + 1 : -1, column > 0 ? blank - 1 : -1,
+            row > 0 ? blank - W : -1, row < H - 1 ? blank + W : -1};
+        for (int i = 0; i < 4; ++i) {
+            int next_blank = neighbours[i];
+            if (next_blank == -1) {
+                continue;
+            }
+            uint32_t next;
+            uint8_t next_distance;
+            int tile = tile_in[next_blank];
+            if (tile == -1) {
+                // A tile of another group, so the move is free.
+                next = rank * kCells + next_blank;
+                next_distance = distance;
+            } else {
+                cells[tile] = blank;
+                next = RankCells<kCells, kGroupSize>(cells) * kCells +
+                    next_blank;
+                cells[tile] = next_blank;
+                next_distance = distance + 1;
+            }
+            if (next_distance < distances[next]) {
+                distances[next] = next_distance;
+                if (next_distance == distance) {
+                    queue.push_front(next);
+                } else {
+                    queue.push_back(next);
+                }
+            }
+        }
+    }
+
+    // Wherever the empty space is, the group needs at least the fewest
+    // moves over every cell it could be in.
+    uint8_t* table = &this->tables_[(goal * kGroups + group) *
+                                    kEntriesPerTable];
+    for (uint32_t rank = 0; rank < kEntriesPerTable; ++rank) {
+        uint8_t fewest = UNREACHED;
+        for (int blank = 0; blank < kCells; ++blank) {
+            if (distances[rank * kCells + blank] < fewest) {
+                fewest = distances[rank * kCells + blank];
+            }
+        }
+        table[rank] = fewest;
+    }
+}
+
+// The board sizes the solver supports: the 8-, 15- and 24-puzzle.
+template class PatternDatabase<3, 3>;
+template class PatternDatabase<4, 4>;
+template class PatternDatabase<5, 5>;
@@ -0,0 +1,236 @@
+//////////////////////////////////////////////////////////
+// Assignment 1 : Lucas Silva                           //
+// The implementation file for the performance counters //
+//////////////////////////////////////////////////////////
+
+#include <stdint.h>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "headers/perf_counters.h"
+
+const char* const PerfCounters::kEventNames[PerfCounters::kEvents] = {
+    "cycles", "instructions", "l1d_misses", "llc_misses", "branch_misses"};
+
+#ifdef __linux__
+namespace {
+
+/**
+ * Opens a counter for the calling thread and the threads it starts, on any
+ * cpu, stopped until it is enabled.
+ * @param {uint32_t} type The type of the counter.
+ * @param {uint64_t} config Which counter of that type.
+ * @return {int} the file of the counter, -1 if it could not be opened.
+ */
+int OpenCounter(uint32_t type, uint64_t config) {
+    struct perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = 1;
+    attr.inherit = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    // With more counters than the machine has, they take turns, and the
+    // times tell how much of the phase each one saw.
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED |
+        PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+}  // namespace
+#endif
+
+/*
+ * Constructor for the PerfCounters class, which opens the counters.
+ * @param {vector<string>} phase_names The name of each phase.
+ */
+PerfCounters::PerfCounters(const std::vector<std::string> &phase_names) :
+    phase_names_(phase_names), readings_(phase_names.size()), phase_(-1) {
+    for (size_t i = 0; i < this->readings_.size(); ++i) {
+        for (int j = 0; j < kEvents; ++j) {
+            this->readings_[i].counts[j] = 0;
+        }
+        this->readings_[i].wall_ms = 0;
+    }
+    std::memset(this->start_, 0, sizeof(this->start_));
+
+#ifdef __linux__
+    this->files_[0] = OpenCounter(PERF_TYPE_HARDWARE,
+                                  PERF_COUNT_HW_CPU_CYCLES);
+    this->files_[1] = OpenCounter(PERF_TYPE_HARDWARE,
+                                  PERF_COUNT_HW_INSTRUCTIONS);
+    this->files_[2] = OpenCounter(PERF_TYPE_HW_CACHE,
+                                  PERF_COUNT_HW_CACHE_L1D |
+                                  (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                  (PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+    // The generic cache misses are those of the last level cache.
+    this->files_[3] = OpenCounter(PERF_TYPE_HARDWARE,
+                                  PERF_COUNT_HW_CACHE_MISSES);
+    this->files_[4] = OpenCounter(PERF_TYPE_HARDWARE,
+                                  PERF_COUNT_HW_BRANCH_MISSES);
+#else
+    for (int i = 0; i < kEvents; ++i) {
+        this->files_[i] = -1;
+    }
+#endif
+    for (int i = 0; i < kEvents; ++i) {
+        if (this->files_[i] != -1) {
+            continue;
+        }
+        for (size_t j = 0; j < this->readings_.size(); ++j) {
+            this->readings_[j].counts[i] = -1;
+        }
+    }
+}
+
+/*
+ * Destructor for the PerfCounters class, which closes the counters.
+ */
+PerfCounters::~PerfCounters() {
+#ifdef __linux__
+    for (int i = 0; i < kEvents; ++i) {
+        if (this->files_[i] != -1) {
+            close(this->files_[i]);
+        }
+    }
+#endif
+}
+
+/**
+ * Checks if any of the counters could be opened.
+ * @return {boolean} true if at least one counter is available.
+ */
+bool PerfCounters::IsAvailable() const {
+    for (int i = 0; i < kEvents; ++i) {
+        if (this->files_[i] != -1) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Starts counting a phase, stopping the phase before it if there is one.
+ * @param {int} phase The index of the phase.
+ */
+void PerfCounters::Start(int phase) {
+    this->Stop();
+    this->phase_ = phase;
+    for (int i = 0; i < kEvents; ++i) {
+        if (!this->Read_(i, this->start_[i])) {
+            continue;
+        }
+#ifdef __linux__
+        ioctl(this->files_[i], PERF_EVENT_IOC_ENABLE, 0);
+#endif
+    }
+    // The clock is read last, so it doesn't count opening the phase.
+    this->start_time_ = std::chrono::steady_clock::now();
+}
+
+/**
+ * Stops counting, and adds what was counted to the current phase.
+ */
+void PerfCounters::Stop() {
+    if (this->phase_ == -1) {
+        return;
+    }
+    std::chrono::duration<double, std::milli> elapsed =
+        std::chrono::steady_clock::now() - this->start_time_;
+    Reading &reading = this->readings_[this->phase_];
+    reading.wall_ms += elapsed.count();
+
+    for (int i = 0; i < kEvents; ++i) {
+        if (this->files_[i] == -1) {
+            continue;
+        }
+#ifdef __linux__
+        ioctl(this->files_[i], PERF_EVENT_IOC_DISABLE, 0);
+#endif
+        uint64_t values[3];
+        if (!this->Read_(i, values)) {
+            continue;
+        }
+        uint64_t counted = values[0] - this->start_[i][0];
+        uint64_t enabled = values[1] - this->start_[i][1];
+        uint64_t running = values[2] - this->start_[i][2];
+        // Scale a counter that only ran for part of the phase up to all of
+        // it.
+        if (running > 0 && running < enabled) {
+            counted = static_cast<uint64_t>(
+                static_cast<double>(counted) * enabled / running);
+        }
+        reading.counts[i] += counted;
+    }
+    this->phase_ = -1;
+}
+
+/**
+ * Writes the counts of every phase as a table, with "n/a" for the counters
+ * that aren't available.
+ * @param {ostream} out The stream to write to.
+ */
+void PerfCounters::Write(std::ostream &out) const {
+    std::ios::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision();
+    out << std::left << std::setw(10) << "phase" << std::right;
+    out << std::setw(12) << "wall_ms";
+    for (int i = 0; i < kEvents; ++i) {
+        out << std::setw(15) << kEventNames[i];
+    }
+    out << std::endl;
+
+    for (size_t i = 0; i < this->readings_.size(); ++i) {
+        const Reading &reading = this->readings_[i];
+        out << std::left << std::setw(10) << this->phase_names_[i];
+        out << std::right << std::setw(12) << std::fixed;
+        out << std::setprecision(3) << reading.wall_ms;
+        for (int j = 0; j < kEvents; ++j) {
+            out << std::setw(15);
+            if (reading.counts[j] == -1) {
+                out << "n/a";
+            } else {
+                out << reading.counts[j];
+            }
+        }
+        out << std::endl;
+    }
+    out.flags(flags);
+    out.precision(precision);
+}
+
+//////////////////////////////
+// Private helper functions //
+//////////////////////////////
+
+/**
+ * Reads the value, time enabled and time running of a counter.
+ * @param {int} event The index of the counter.
+ * @param {uint64_t[3]} values Filled with what was read.
+ * @return {boolean} true if the counter could be read.
+ * @private
+ */
+bool PerfCounters::Read_(int event, uint64_t values[3]) const {
+    if (this->files_[event] == -1) {
+        return false;
+    }
+#ifdef __linux__
+    ssize_t size = sizeof(uint64_t) * 3;
+    return read(this->files_[event], values, size) == size;
+#else
+    return false;
+#endif
+}
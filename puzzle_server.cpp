@@ -0,0 +1,299 @@
+///////////////////////////////////////////////////
+// Assignment 1 : Lucas Silva                    //
+// The implementation file for the puzzle server //
+///////////////////////////////////////////////////
+
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "headers/puzzle_server.h"
+
+namespace {
+
+/* The most connections waiting to be accepted. */
+const int kBacklog = 16;
+
+/* The number of bytes read from a connection at a time. */
+const size_t kReadSize = 4096;
+
+/**
+ * Checks if a line holds nothing but white space.
+ * @param {string} line The line.
+ * @return {boolean} true if the line is blank.
+ */
+bool IsBlank(const std::string &line) {
+    return line.find_first_not_of(" \t\r\n") == std::string::npos;
+}
+
+/**
+ * Removes the socket a stopped server left at a path, so it can be bound
+ * again. Anything else at the path, a file or the socket of a server that
+ * is still running, is left alone.
+ * @param {string} path The path of the socket.
+ * @param {sockaddr_un} address The address of the socket.
+ * @return {boolean} true if nothing is left at the path.
+ */
+bool RemoveStaleSocket(const std::string &path, const sockaddr_un &address) {
+    struct stat status;
+    if (lstat(path.c_str(), &status) < 0) {
+        if (errno == ENOENT) {
+            return true;
+        }
+        std::cerr << "Could not check " << path << ": ";
+        std::cerr << std::strerror(errno) << std::endl;
+        return false;
+    }
+    if (!S_ISSOCK(status.st_mode)) {
+        std::cerr << path << " already exists and is not a socket";
+        std::cerr << std::endl;
+        return false;
+    }
+
+    // Only a socket nothing listens on any more is stale.
+    int probe = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (probe < 0) {
+        std::cerr << "Could not create a socket: " << std::strerror(errno);
+        std::cerr << std::endl;
+        return false;
+    }
+    int connected = connect(probe,
+                            reinterpret_cast<const sockaddr*>(&address),
+                            sizeof(address));
+    int connect_error = errno;
+    close(probe);
+    if (connected == 0) {
+        std::cerr << "Another server is already listening on " << path;
+        std::cerr << std::endl;
+        return false;
+    }
+    if (connect_error != ECONNREFUSED) {
+        std::cerr << "Could not check " << path << ": ";
+        std::cerr << std::strerror(connect_error) << std::endl;
+        return false;
+    }
+    if (unlink(path.c_str()) < 0) {
+        std::cerr << "Could not remove " << path << ": ";
+        std::cerr << std::strerror(errno) << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Sends the whole of a string on a connection. A client that went away
+ * only fails the send, rather than raising SIGPIPE.
+ * @param {int} connection The connected socket.
+ * @param {string} text The text to send.
+ * @return {boolean} false if the connection failed.
+ */
+bool SendAll(int connection, const std::string &text) {
+    size_t sent = 0;
+    while (sent < text.size()) {
+        ssize_t count = send(connection, text.data() + sent,
+                             text.size() - sent, MSG_NOSIGNAL);
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count <= 0) {
+            return false;
+        }
+        sent += static_cast<size_t>(count);
+    }
+    return true;
+}
+
+}  // namespace
+
+/**
+ * Answers every board read from a stream, until it ends. Each answer is
+ * flushed as soon as it is written.
+ * @param {istream} in The stream to read the boards from.
+ * @param {ostream} out The stream to write the answers to.
+ * @return {int} the number of boards solved.
+ */
+int PuzzleServer::ServeStream(std::istream &in, std::ostream &out) {
+    Solver solver(&this->table_, this->cache_);
+    SolveResult result;
+    std::string line;
+    int solved = 0;
+    while (std::getline(in, line)) {
+        if (IsBlank(line)) {
+            continue;
+        }
+        if (this->Answer_(line, solver, result, out)) {
+            ++solved;
+        }
+        out << std::endl;
+    }
+    return solved;
+}
+
+/**
+ * Listens on a Unix domain socket, replacing the socket a stopped server
+ * left at its path, and answers the boards sent on every connection to
+ * it. A file, or the socket of a server that is still listening, is left
+ * alone and the socket isn't opened. Only returns if the socket can't be
+ * opened, or stops accepting.
+ * @param {string} path The path of the socket.
+ * @return {boolean} false if the socket couldn't be opened.
+ */
+bool PuzzleServer::ServeSocket(const std::string &path) {
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path)) {
+        std::cerr << "The socket path is too long: " << path << std::endl;
+        return false;
+    }
+    std::strcpy(address.sun_path, path.c_str());
+
+    // A server that was stopped leaves its socket behind.
+    if (!RemoveStaleSocket(path, address)) {
+        return false;
+    }
+    int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener < 0) {
+        std::cerr << "Could not create a socket: " << std::strerror(errno);
+        std::cerr << std::endl;
+        return false;
+    }
+    if (bind(listener, reinterpret_cast<sockaddr*>(&address),
+             sizeof(address)) < 0 || listen(listener, kBacklog) < 0) {
+        std::cerr << "Could not listen on " << path << ": ";
+        std::cerr << std::strerror(errno) << std::endl;
+        close(listener);
+        return false;
+    }
+    std::cerr << "Listening on " << path << std::endl;
+
+    int threads = this->threads_ < 1 ? 1 : this->threads_;
+    std::vector<std::thread> workers;
+    for (int i = 1; i < threads; ++i) {
+        workers.push_back(std::thread(&PuzzleServer::Work_, this, listener));
+    }
+    // This thread is the first worker.
+    this->Work_(listener);
+    for (size_t i = 0; i < workers.size(); ++i) {
+        workers[i].join();
+    }
+
+    close(listener);
+    unlink(path.c_str());
+    return true;
+}
+
+//////////////////////////////
+// Private helper functions //
+//////////////////////////////
+
+/**
+ * Accepts connections to the socket and serves them one at a time, until
+ * accepting fails.
+ * @param {int} listener The listening socket.
+ * @private
+ */
+void PuzzleServer::Work_(int listener) {
+    // The searches of this worker, kept from one connection to the next.
+    Solver solver(&this->table_, this->cache_);
+    std::string pending;
+    while (true) {
+        int connection = accept(listener, NULL, NULL);
+        if (connection < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) {
+                continue;
+            }
+            std::cerr << "Could not accept a connection: ";
+            std::cerr << std::strerror(errno) << std::endl;
+            return;
+        }
+        this->ServeConnection_(connection, solver, pending);
+        close(connection);
+    }
+}
+
+/**
+ * Answers a single line.
+ * @param {string} line The line, a board or "stats".
+ * @param {Solver} solver The solver to solve the board with.
+ * @param {SolveResult} result Filled with what was found.
+ * @param {ostream} out The stream to write the answer to, without the end
+ *   of line.
+ * @return {boolean} true if a board was solved.
+ * @private
+ */
+bool PuzzleServer::Answer_(const std::string &line, Solver &solver,
+                           SolveResult &result, std::ostream &out) {
+    size_t first = line.find_first_not_of(" \t\r");
+    size_t last = line.find_last_not_of(" \t\r");
+    if (line.compare(first, last - first + 1, "stats") == 0) {
+        CacheStats stats;
+        if (this->cache_) {
+            stats = this->cache_->GetStats();
+        }
+        stats.WriteJson(out);
+        return false;
+    }
+    bool solved = solver.Solve(line, this->options_, result);
+    Solver::WriteResult(result, out);
+    return solved;
+}
+
+/**
+ * Answers the boards sent on a connection, until it is closed.
+ * @param {int} connection The connected socket.
+ * @param {Solver} solver The worker's solver.
+ * @param {string} pending A buffer for the part of a line not yet
+ *   answered, kept by the worker.
+ * @private
+ */
+void PuzzleServer::ServeConnection_(int connection, Solver &solver,
+                                    std::string &pending) {
+    SolveResult result;
+    std::ostringstream answer;
+    char buffer[kReadSize];
+    pending.clear();
+    while (true) {
+        ssize_t count = recv(connection, buffer, sizeof(buffer), 0);
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count <= 0) {
+            // A last line without an end of line is still a board.
+            if (count == 0 && !IsBlank(pending)) {
+                answer.str("");
+                this->Answer_(pending, solver, result, answer);
+                answer << "\n";
+                SendAll(connection, answer.str());
+            }
+            return;
+        }
+        pending.append(buffer, static_cast<size_t>(count));
+
+        // Answer every whole line received so far.
+        size_t start = 0;
+        size_t end;
+        while ((end = pending.find('\n', start)) != std::string::npos) {
+            std::string line = pending.substr(start, end - start);
+            start = end + 1;
+            if (IsBlank(line)) {
+                continue;
+            }
+            answer.str("");
+            this->Answer_(line, solver, result, answer);
+            answer << "\n";
+            if (!SendAll(connection, answer.str())) {
+                return;
+            }
+        }
+        pending.erase(0, start);
+    }
+}
@@ -0,0 +1,86 @@
+///////////////////////////////////////////////////////
+// Assignment 1 : Lucas Silva                        //
+// The implementation file for the search statistics //
+///////////////////////////////////////////////////////
+
+#include <iostream>
+#include <vector>
+
+#include "headers/search_stats.h"
+
+#ifdef SEARCH_STATS
+namespace {
+
+/**
+ * Writes a histogram as a JSON object from each value counted to its
+ * count, leaving out the values that were never counted.
+ * @param {ostream} out The stream to write to.
+ * @param {vector<long>} histogram The histogram, indexed by value.
+ */
+void WriteHistogram(std::ostream &out, const std::vector<long> &histogram) {
+    out << "{";
+    bool first = true;
+    for (size_t i = 0; i < histogram.size(); ++i) {
+        if (histogram[i] == 0) {
+            continue;
+        }
+        out << (first ? "" : ", ") << "\"" << i << "\": " << histogram[i];
+        first = false;
+    }
+    out << "}";
+}
+
+/**
+ * Adds one histogram into another, growing it as needed.
+ * @param {vector<long>} histogram The histogram added to.
+ * @param {vector<long>} other The histogram to add.
+ */
+void AddHistogram(std::vector<long> &histogram,
+                  const std::vector<long> &other) {
+    if (other.size() > histogram.size()) {
+        histogram.resize(other.size(), 0);
+    }
+    for (size_t i = 0; i < other.size(); ++i) {
+        histogram[i] += other[i];
+    }
+}
+
+}  // namespace
+#endif
+
+/**
+ * Adds the counts of another search, as when threads search together.
+ * @param {SearchStats} other The counts to add.
+ */
+void SearchStats::Add(const SearchStats &other) {
+    this->expanded += other.expanded;
+    this->reexpanded += other.reexpanded;
+    this->generated += other.generated;
+    this->peak_open += other.peak_open;
+#ifdef SEARCH_STATS
+    this->parent_prunes += other.parent_prunes;
+    this->duplicates += other.duplicates;
+    AddHistogram(this->rank_histogram, other.rank_histogram);
+    AddHistogram(this->depth_histogram, other.depth_histogram);
+#endif
+}
+
+/**
+ * Writes every count as a single JSON object.
+ * @param {ostream} out The stream to write to.
+ */
+void SearchStats::WriteJson(std::ostream &out) const {
+    out << "{\"expanded\": " << this->expanded;
+    out << ", \"reexpanded\": " << this->reexpanded;
+    out << ", \"generated\": " << this->generated;
+    out << ", \"peak_open\": " << this->peak_open;
+#ifdef SEARCH_STATS
+    out << ", \"parent_prunes\": " << this->parent_prunes;
+    out << ", \"duplicates\": " << this->duplicates;
+    out << ", \"rank_histogram\": ";
+    WriteHistogram(out, this->rank_histogram);
+    out << ", \"depth_histogram\": ";
+    WriteHistogram(out, this->depth_histogram);
+#endif
+    out << "}";
+}
@@ -0,0 +1,160 @@
+////////////////////////////////////////////////////
+// Assignment 1 : Lucas Silva                     //
+// The implementation file for the solution cache //
+////////////////////////////////////////////////////
+
+#include <iostream>
+#include <mutex>
+
+#include "headers/solution_cache.h"
+
+/**
+ * Writes the counters as a single JSON object, without the end of line.
+ * @param {ostream} out The stream to write to.
+ */
+void CacheStats::WriteJson(std::ostream &out) const {
+    out << "{\"hits\": " << this->hits;
+    out << ", \"misses\": " << this->misses;
+    out << ", \"insertions\": " << this->insertions;
+    out << ", \"evictions\": " << this->evictions;
+    out << ", \"size\": " << this->size;
+    out << ", \"capacity\": " << this->capacity << "}";
+}
+
+/*
+ * Constructor for the SolutionCache class.
+ * @param {size_t} capacity The most states the cache holds, at least one
+ *   for each shard.
+ */
+SolutionCache::SolutionCache(size_t capacity) {
+    this->shard_capacity_ = capacity / kShards;
+    if (this->shard_capacity_ < 1) {
+        this->shard_capacity_ = 1;
+    }
+}
+
+/**
+ * Gets the counters of every shard, added up.
+ * @return {CacheStats} the counters.
+ */
+CacheStats SolutionCache::GetStats() const {
+    CacheStats stats;
+    for (int i = 0; i < kShards; ++i) {
+        const Shard &shard = this->shards_[i];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        stats.hits += shard.hits;
+        stats.misses += shard.misses;
+        stats.insertions += shard.insertions;
+        stats.evictions += shard.evictions;
+        stats.size += shard.slots.size();
+    }
+    stats.capacity = this->shard_capacity_ * kShards;
+    return stats;
+}
+
+/**
+ * Compares two keys.
+ * @param {Key} other The other key.
+ * @return {boolean} true if both are the same state with the same goal.
+ */
+bool SolutionCache::Key::operator==(const Key &other) const {
+    if (this->cells != other.cells || this->goal != other.goal) {
+        return false;
+    }
+    for (int i = 0; i < kMaxWords; ++i) {
+        if (this->words[i] != other.words[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+//////////////////////////////
+// Private helper functions //
+//////////////////////////////
+
+/**
+ * Mixes the words of a key into a well distributed hash.
+ * @param {Key} key The key.
+ * @return {uint64_t} the hash of the key.
+ * @private
+ */
+uint64_t SolutionCache::HashKey_(const Key &key) {
+    uint64_t hash = static_cast<uint64_t>(key.cells);
+    for (int i = 0; i <= kMaxWords; ++i) {
+        hash ^= i < kMaxWords ? key.words[i] : key.goal;
+        hash ^= hash >> 33;
+        hash *= 0xff51afd7ed558ccdULL;
+        hash ^= hash >> 33;
+        hash *= 0xc4ceb9fe1a85ec53ULL;
+        hash ^= hash >> 33;
+    }
+    return hash;
+}
+
+/**
+ * Looks up the solution stored for a key.
+ * @param {Key} key The key.
+ * @param {MoveSequence} moves Set to the moves, if the key is there.
+ * @return {boolean} true if the key is in the cache.
+ * @private
+ */
+bool SolutionCache::Lookup_(const Key &key, MoveSequence &moves) {
+    // The index of each shard uses the low bits of the hash, so the shard
+    // is picked with the high ones.
+    Shard &shard = this->shards_[(HashKey_(key) >> 32) % kShards];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    std::unordered_map<Key, size_t, KeyHash>::const_iterator it =
+        shard.index.find(key);
+    if (it == shard.index.end()) {
+        ++shard.misses;
+        return false;
+    }
+    Slot &slot = shard.slots[it->second];
+    slot.referenced = true;
+    moves = slot.moves;
+    ++shard.hits;
+    return true;
+}
+
+/**
+ * Stores the solution for a key.
+ * @param {Key} key The key.
+ * @param {MoveSequence} moves The moves of the solution.
+ * @private
+ */
+void SolutionCache::Insert_(const Key &key, const MoveSequence &moves) {
+    Shard &shard = this->shards_[(HashKey_(key) >> 32) % kShards];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    // Every shortest solution from a state is as long as any other, so
+    // the one already there is kept.
+    if (shard.index.find(key) != shard.index.end()) {
+        return;
+    }
+    ++shard.insertions;
+
+    if (shard.slots.size() < this->shard_capacity_) {
+        Slot slot;
+        slot.key = key;
+        slot.moves = moves;
+        slot.referenced = false;
+        shard.index[key] = shard.slots.size();
+        shard.slots.push_back(slot);
+        return;
+    }
+
+    // Sweep the hand past every state used since it last went by, giving
+    // each one another turn, and evict the first that wasn't.
+    while (shard.slots[shard.hand].referenced) {
+        shard.slots[shard.hand].referenced = false;
+        shard.hand = (shard.hand + 1) % shard.slots.size();
+    }
+    Slot &victim = shard.slots[shard.hand];
+    shard.index.erase(victim.key);
+    ++shard.evictions;
+    victim.key = key;
+    victim.moves = moves;
+    victim.referenced = false;
+    shard.index[key] = shard.hand;
+    shard.hand = (shard.hand + 1) % shard.slots.size();
+}
@@ -0,0 +1,250 @@
+////////////////////////////////////////////
+// Assignment 1 : Lucas Silva             //
+// The implementation file for the solver //
+////////////////////////////////////////////
+
+#include <cstdio>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "headers/solver.h"
+#include "headers/board.h"
+
+namespace {
+
+/* The letter written for each direction, indexed by the direction. */
+const char DIRECTION_LETTERS[5] = {'?', 'R', 'L', 'U', 'D'};
+
+/**
+ * Finds a solution from the distance table. Only the 8-puzzle has one.
+ * @param {Board} board The board.
+ * @param {DistanceTable} table The distance table.
+ * @param {MoveSequence} path Filled with the moves.
+ * @return {boolean} true if a solution was found.
+ */
+bool FindPathInTable(const Board<3, 3> &board, const DistanceTable &table,
+                     MoveSequence &path) {
+    return table.FindPath(board, path);
+}
+
+/**
+ * Larger boards have no distance table, so no solution is found.
+ * @return {boolean} false.
+ */
+template <int W, int H>
+bool FindPathInTable(const Board<W, H> & /* board */,
+                     const DistanceTable & /* table */,
+                     MoveSequence & /* path */) {
+    return false;
+}
+
+}  // namespace
+
+/*
+ * Destructor for the Solver class, which frees the searches.
+ */
+Solver::~Solver() {
+    delete this->searches_3x3_;
+    delete this->searches_4x4_;
+    delete this->searches_5x5_;
+}
+
+/**
+ * Solves a board. The size of the board is decided by the number of
+ * tiles, like the solver does.
+ * @param {string} input The tiles of the board.
+ * @param {SolveOptions} options How to solve it.
+ * @param {SolveResult} result Filled with what was found.
+ * @return {boolean} true if the board was solved.
+ */
+bool Solver::Solve(const std::string &input, const SolveOptions &options,
+                   SolveResult &result) {
+    // Anything that isn't a 15- or 24-puzzle is read as an 8-puzzle,
+    // which reports what is wrong with the input.
+    ParseTiles(input, this->tiles_);
+    size_t tiles = this->tiles_.size();
+    if (tiles == 16) {
+        return this->Solve_(input, options, this->searches_4x4_, result);
+    }
+    if (tiles == 25) {
+        return this->Solve_(input, options, this->searches_5x5_, result);
+    }
+    return this->Solve_(input, options, this->searches_3x3_, result);
+}
+
+/**
+ * Writes a result on a single line, without the end of line: the number
+ * of moves and the direction of each move (R, L, U or D for where the
+ * empty space went), then the bound if the solution may not be a shortest
+ * one, or else why the board wasn't solved.
+ * @param {SolveResult} result The result.
+ * @param {ostream} out The stream to write to.
+ */
+void Solver::WriteResult(const SolveResult &result, std::ostream &out) {
+    if (!result.solved) {
+        out << result.error;
+        return;
+    }
+
+    out << result.moves.size() << " moves";
+    if (!result.moves.empty()) {
+        out << " ";
+        for (size_t i = 0; i < result.moves.size(); ++i) {
+            out << DIRECTION_LETTERS[result.moves[i]];
+        }
+    }
+    if (result.bound > 1) {
+        char bound[32];
+        std::snprintf(bound, sizeof(bound), " bound %.2f", result.bound);
+        out << bound;
+    }
+}
+
+//////////////////////////////
+// Private helper functions //
+//////////////////////////////
+
+/**
+ * Solves a board of a given size.
+ * @param {string} input The tiles of the board.
+ * @param {SolveOptions} options How to solve it.
+ * @param {Searches*} searches The searches for the size, made if NULL.
+ * @param {SolveResult} result Filled with what was found.
+ * @return {boolean} true if the board was solved.
+ * @private
+ */
+template <int W, int H>
+bool Solver::Solve_(const std::string &input, const SolveOptions &options,
+                    Searches<W, H>* &searches, SolveResult &result) {
+    result.solved = false;
+    result.error = NULL;
+    result.moves.clear();
+    result.bound = 1;
+    result.expanded = 0;
+    result.cached = false;
+
+    int search = options.search;
+    if (search == TABLE_WALK && this->table_ == NULL) {
+        result.error = "there is no distance table";
+        return false;
+    }
+    if (search == TABLE_WALK && W * H != 9) {
+        result.error = "the distance table only holds 8-puzzle boards";
+        return false;
+    }
+
+    if (searches == NULL) {
+        searches = new Searches<W, H>();
+    }
+    searches->problem.input = input;
+    Board<W, H> board(&searches->problem);
+    if (!board.CreateBoard()) {
+        result.error = "invalid board";
+        return false;
+    }
+    if (board.IsAtGoalState()) {
+        result.solved = true;
+        return true;
+    }
+    if (!board.IsSolvable()) {
+        result.error = "not solvable";
+        return false;
+    }
+    if (search == TABLE_WALK) {
+        result.solved = FindPathInTable(board, *this->table_, result.moves);
+        if (!result.solved) {
+            result.error = "no solution found";
+        }
+        return result.solved;
+    }
+
+    // A shortest solution is within any bound, so it does for every search.
+    if (this->cache_ && this->cache_->Lookup(board.GetState(),
+                                             board.GetGoalStateType(),
+                                             result.moves)) {
+        result.cached = true;
+        result.solved = true;
+        return true;
+    }
+
+    bool found;
+    const MoveSequence* path;
+    const SearchStats* stats;
+    // A search that runs out of memory leaves its size's searches in no
+    // state to be reused, so they are thrown away and made again by the
+    // next board, and the solver goes on with other boards.
+    try {
+        if (search == IDA_STAR_SEARCH) {
+            found = searches->ida_star.Solve(board);
+            path = &searches->ida_star.GetPath();
+            stats = &searches->ida_star.GetStats();
+        } else if (search == BIDIRECTIONAL_SEARCH) {
+            found = searches->bidirectional.Solve(board);
+            path = &searches->bidirectional.GetPath();
+            stats = &searches->bidirectional.GetStats();
+        } else if (search == WEIGHTED_SEARCH) {
+            searches->anytime.SetSettings(options.anytime);
+            found = searches->anytime.Solve(board);
+            path = &searches->anytime.GetPath();
+            stats = &searches->anytime.GetStats();
+            result.bound = searches->anytime.GetBound();
+        } else if (search == PARTIAL_EXPANSION_SEARCH) {
+            found = searches->a_star_partial.Solve(board);
+            path = &searches->a_star_partial.GetPath();
+            stats = &searches->a_star_partial.GetStats();
+        } else if (search == BUCKET_SEARCH) {
+            found = searches->a_star_buckets.Solve(board);
+            path = &searches->a_star_buckets.GetPath();
+            stats = &searches->a_star_buckets.GetStats();
+        } else {
+            found = searches->a_star_heap.Solve(board);
+            path = &searches->a_star_heap.GetPath();
+            stats = &searches->a_star_heap.GetStats();
+        }
+    } catch (const std::bad_alloc &) {
+        delete searches;
+        searches = NULL;
+        result.error = "out of memory";
+        return false;
+    }
+    result.expanded = stats->expanded;
+    if (!found) {
+        result.error = search == WEIGHTED_SEARCH &&
+            searches->anytime.IsOutOfBudget() ?
+            "no solution found within the budget" : "no solution found";
+        return false;
+    }
+    // Copied into the result's own words, which keep their memory.
+    result.moves = *path;
+    result.solved = true;
+    if (this->cache_ && result.bound <= 1) {
+        this->CacheSolution_(board, result.moves);
+    }
+    return true;
+}
+
+/**
+ * Stores every state on a shortest solution in the cache, with the moves
+ * left from it.
+ * @param {Board} board The initial board.
+ * @param {MoveSequence} moves The moves of the solution.
+ * @private
+ */
+template <int W, int H>
+void Solver::CacheSolution_(const Board<W, H> &board,
+                            const MoveSequence &moves) {
+    // Every part of a shortest solution that ends at the goal state is a
+    // shortest solution from where it starts.
+    Board<W, H> scratch(board);
+    for (size_t i = 0; i < moves.size(); ++i) {
+        this->suffix_.clear();
+        for (size_t j = i; j < moves.size(); ++j) {
+            this->suffix_.push_back(moves[j]);
+        }
+        this->cache_->Insert(scratch.GetState(), board.GetGoalStateType(),
+                             this->suffix_);
+        scratch.MoveInDirection(moves[i]);
+    }
+}